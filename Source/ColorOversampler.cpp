@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+    ColorOversampler.cpp (SPLENTA V19.6 - 20261016.01)
+    Oversampled COLOR Layer: Half-Band Decimator Cascade
+  ==============================================================================
+*/
+
+#include "ColorOversampler.h"
+
+namespace
+{
+    // Taps per stage (4k + 3 so the outermost taps are non-zero). The final 2x -> 1x
+    // stage has the narrowest transition band; the earlier ones only need to keep
+    // their images away from the final stage's passband.
+    constexpr int finalStageTaps = 47;
+    constexpr int earlyStageTaps = 23;
+}
+
+void ColorOversampler::HalfBandStage::prepare(int newNumTaps, int maxInputSamples)
+{
+    jassert ((newNumTaps - 3) % 4 == 0);
+    numTaps = newNumTaps;
+    padding = 0;
+
+    // Windowed-sinc half-band (cutoff fs/4): even offsets are zero, the centre is 0.5
+    const int centre = (numTaps - 1) / 2;
+    oddTaps.assign((size_t) (centre + 1) / 2, 0.0f);
+
+    double sum = 0.0;
+    for (size_t k = 0; k < oddTaps.size(); ++k)
+    {
+        const int offset = 2 * (int) k + 1;
+        const double n = (double) (centre + offset) / (double) (numTaps - 1);
+        const double twoPi = juce::MathConstants<double>::twoPi;
+
+        // 4-term Blackman-Harris window
+        const double window = 0.35875 - 0.48829 * std::cos(twoPi * n) + 0.14128 * std::cos(2.0 * twoPi * n) - 0.01168 * std::cos(3.0 * twoPi * n);
+        const double sinc = std::sin(juce::MathConstants<double>::halfPi * offset) / (juce::MathConstants<double>::pi * offset);
+
+        oddTaps[k] = (float) (sinc * window);
+        sum += 2.0 * sinc * window;
+    }
+
+    // Unity gain at DC: the odd taps sum to 0.5 alongside the 0.5 centre tap
+    for (auto& tap : oddTaps)
+        tap = (float) (tap * 0.5 / sum);
+
+    // History (taps + the largest padding) followed by one block of input
+    work.assign((size_t) (numTaps - 1 + (1 << maxFactorIndex) + maxInputSamples), 0.0f);
+}
+
+void ColorOversampler::HalfBandStage::reset() noexcept
+{
+    std::fill(work.begin(), work.end(), 0.0f);
+}
+
+void ColorOversampler::HalfBandStage::process(const float* input, float* output, int numOutputSamples) noexcept
+{
+    const int history = numTaps - 1 + padding;
+    const int numInputSamples = 2 * numOutputSamples;
+    jassert (history + numInputSamples <= (int) work.size());
+
+    auto* w = work.data();
+    std::copy(input, input + numInputSamples, w + history);
+
+    const int centreOffset = history + 1 - padding - (numTaps - 1) / 2;
+    const int numPairs = (int) oddTaps.size();
+
+    for (int m = 0; m < numOutputSamples; ++m)
+    {
+        const float* centre = w + centreOffset + 2 * m;
+        float y = centreTap * centre[0];
+
+        for (int k = 0; k < numPairs; ++k)
+            y += oddTaps[(size_t) k] * (centre[-(2 * k + 1)] + centre[2 * k + 1]);
+
+        output[m] = y;
+    }
+
+    // Keep the newest samples as history for the next block
+    std::copy(w + numInputSamples, w + numInputSamples + history, w);
+}
+
+void ColorOversampler::prepare(int maxBlockSize, int switchFadeSamples)
+{
+    const int maxFactor = 1 << maxFactorIndex;
+    highRate.setSize(1, juce::jmax(1, maxBlockSize) * maxFactor);
+    stageBuffer.setSize(2, juce::jmax(1, maxBlockSize) * maxFactor / 2);
+
+    for (int s = 0; s < numStages; ++s)
+        stages[s].prepare(s == 0 ? finalStageTaps : earlyStageTaps, juce::jmax(1, maxBlockSize) << (s + 1));
+
+    switchStep = 1.0f / (float) juce::jmax(1, switchFadeSamples);
+
+    configure(maxFactorIndex);
+    maxLatencySamples = latencySamples;
+    setFactorIndex(targetFactorIndex);
+}
+
+void ColorOversampler::reset() noexcept
+{
+    // Silent anyway: a pending switch completes here
+    if (targetFactorIndex != factorIndex)
+        configure(targetFactorIndex);
+
+    switchGain = 1.0f;
+    clearState();
+}
+
+void ColorOversampler::clearState() noexcept
+{
+    highRate.clear();
+    for (auto& stage : stages)
+        stage.reset();
+}
+
+void ColorOversampler::setFactorIndex(int newFactorIndex) noexcept
+{
+    targetFactorIndex = juce::jlimit(0, maxFactorIndex, newFactorIndex);
+    configure(targetFactorIndex);
+    switchGain = 1.0f;
+    clearState();
+}
+
+void ColorOversampler::requestFactorIndex(int newFactorIndex) noexcept
+{
+    // Requesting the running factor mid-fade just fades back in
+    targetFactorIndex = juce::jlimit(0, maxFactorIndex, newFactorIndex);
+}
+
+void ColorOversampler::configure(int newFactorIndex) noexcept
+{
+    factorIndex = newFactorIndex;
+    const int factor = getFactor();
+
+    // Delay of the active stages in high-rate samples (stage s runs at 2^(s + 1) x)
+    int delay = 0;
+    for (int s = 0; s < numStages; ++s)
+    {
+        stages[s].padding = 0;
+        if (s < factorIndex)
+            delay += stages[s].getDelay() * (factor >> (s + 1));
+    }
+
+    // Pad the first (highest-rate) stage up to a whole base-rate sample
+    if (factorIndex > 0)
+    {
+        const int padding = (factor - delay % factor) % factor;
+        stages[factorIndex - 1].padding = padding;
+        delay += padding;
+    }
+
+    latencySamples = delay / factor;
+}
+
+void ColorOversampler::downsample(float* dest, int numSamples) noexcept
+{
+    const float* input = highRate.getReadPointer(0);
+
+    if (factorIndex == 0)
+    {
+        juce::FloatVectorOperations::copy(dest, input, numSamples);
+    }
+    else
+    {
+        // Ping-pong through the intermediate buffers, last stage straight into dest
+        for (int s = factorIndex - 1; s >= 0; --s)
+        {
+            float* output = (s == 0) ? dest : stageBuffer.getWritePointer(s % 2);
+            stages[s].process(input, output, numSamples << s);
+            input = output;
+        }
+    }
+
+    if (targetFactorIndex != factorIndex || switchGain < 1.0f)
+        applySwitchFade(dest, numSamples);
+}
+
+void ColorOversampler::applySwitchFade(float* dest, int numSamples) noexcept
+{
+    const bool fadingOut = targetFactorIndex != factorIndex;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        switchGain = fadingOut ? juce::jmax(0.0f, switchGain - switchStep)
+                               : juce::jmin(1.0f, switchGain + switchStep);
+        dest[i] *= switchGain;
+    }
+
+    // Silent by the end of the block: switch and start the new chain from clean history
+    if (fadingOut && switchGain <= 0.0f)
+    {
+        configure(targetFactorIndex);
+        clearState();
+    }
+}
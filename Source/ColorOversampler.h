@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+    ColorOversampler.h (SPLENTA V19.6 - 20261016.01)
+    Oversampled COLOR Layer: Half-Band Decimator Cascade
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// The COLOR waveshaper runs at 1x/2x/4x/8x. Its input needs no upsampling
+// filter: the voices read their band-limited wavetables directly at the
+// oversampled rate into getHighRateBuffer(). This class only brings the shaped
+// layer back down through linear-phase half-band FIR stages (2:1 each).
+//
+// The first stage is padded so the total delay is a whole number of base-rate
+// samples (getLatencySamples), which lets the clean layer and the dry path be
+// delayed by exactly the same amount. All buffers are sized in prepare() for
+// 8x, so changing the factor never allocates.
+//
+// During playback a factor change (requestFactorIndex) never restarts a live
+// chain: the layer fades to silence, switches and clears the stage history
+// while silent, then fades back in on the new chain.
+class ColorOversampler
+{
+public:
+    static constexpr int maxFactorIndex = 3;  // 8x
+
+    void prepare(int maxBlockSize, int switchFadeSamples);
+    void reset() noexcept;
+
+    // 0 = 1x, 1 = 2x, 2 = 4x, 3 = 8x. setFactorIndex switches at once (not while
+    // playing); requestFactorIndex switches behind the fade, at a block boundary.
+    void setFactorIndex(int newFactorIndex) noexcept;
+    void requestFactorIndex(int newFactorIndex) noexcept;
+    int getFactor() const noexcept { return 1 << factorIndex; }
+    int getLatencySamples() const noexcept { return latencySamples; }
+    int getMaxLatencySamples() const noexcept { return maxLatencySamples; }
+
+    // numSamples * getFactor() samples of the shaped layer, written by the voices
+    float* getHighRateBuffer() noexcept { return highRate.getWritePointer(0); }
+
+    // Decimates numSamples * getFactor() high-rate samples into numSamples at dest.
+    // May complete a requested switch (getFactor / getLatencySamples change after it).
+    void downsample(float* dest, int numSamples) noexcept;
+
+private:
+    struct HalfBandStage
+    {
+        void prepare(int numTaps, int maxInputSamples);
+        void reset() noexcept;
+
+        // Output m lines up with input 2m + 1; delay = (numTaps - 1) / 2 + padding input samples
+        void process(const float* input, float* output, int numOutputSamples) noexcept;
+
+        int getDelay() const noexcept { return (numTaps - 1) / 2 + padding; }
+
+        int numTaps = 0;
+        int padding = 0;
+        float centreTap = 0.5f;
+        std::vector<float> oddTaps;    // h[centre +- (2k + 1)], symmetric
+        std::vector<float> work;       // history + current input
+    };
+
+    static constexpr int numStages = maxFactorIndex;
+
+    void configure(int newFactorIndex) noexcept;   // Padding + latency for a factor
+    void clearState() noexcept;
+    void applySwitchFade(float* dest, int numSamples) noexcept;
+
+    // stages[s] takes 2^(s + 1) x down to 2^s x (stage 0 is the final 2x -> 1x)
+    HalfBandStage stages[numStages];
+    juce::AudioBuffer<float> highRate, stageBuffer;
+    int factorIndex = 0;
+    int latencySamples = 0;
+    int maxLatencySamples = 0;
+
+    // Factor switch: fade out, switch while silent, fade in
+    int targetFactorIndex = 0;
+    float switchGain = 1.0f;
+    float switchStep = 1.0f;
+};
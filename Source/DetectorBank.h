@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+    DetectorBank.h (SPLENTA V19.6 - 20261016.01)
+    Multiband Trigger Detector: Band-Pass Biquads in Parallel Lanes
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Up to maxBands band-pass detectors on the same key signal, each with its own
+// frequency, Q, threshold and trigger routing. Every per-band field is an array
+// indexed by band, so one sample of the whole bank is a set of fixed-length lane
+// loops (biquad, rectifier, envelope follower, threshold test) that compile to
+// one vector operation each: four bands cost about as much as one.
+//
+// The detector law turns the rectified band signal into a level before the
+// release follower: instantaneous peak, sliding-window RMS (running sum over a
+// ring), sliding-window peak hold (running maximum over a monotonic deque) or
+// the mean of the two. Every law is O(1) per sample whatever the window length.
+//
+// Band 0 is the main detector; it feeds the audition output and the scopes.
+// Filter state is kept in double so either processing precision can resume it.
+class DetectorBank
+{
+public:
+    static constexpr int maxBands = 4;
+
+    enum class Law { peak = 0, rms, peakHold, hybrid };
+
+    DetectorBank() { reset(); }
+
+    // Allocates the window history for windows up to maxWindowSamples
+    void prepare(int maxWindowSamples)
+    {
+        const int capacity = juce::nextPowerOfTwo(juce::jmax(2, maxWindowSamples + 1));
+        historyMask = (juce::uint32) capacity - 1;
+        history.assign((size_t) capacity * maxBands, 0.0f);
+        dequeIndices.assign((size_t) capacity * maxBands, 0);
+        windowSamples = juce::jlimit(1, capacity - 1, windowSamples);
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        inputX1 = inputX2 = 0.0;
+        for (int b = 0; b < maxBands; ++b)
+        {
+            y1[b] = 0.0;
+            y2[b] = 0.0;
+            envelope[b] = 0.0f;
+        }
+        clearHistory();
+    }
+
+    // The laws keep different parts of the window state (peak none, hold no running
+    // sum), so a switch restarts the window history
+    void setLaw(Law newLaw) noexcept
+    {
+        if (newLaw != law)
+        {
+            law = newLaw;
+            clearHistory();
+        }
+    }
+
+    // Sliding window for the RMS / peak-hold laws (restarts the window history)
+    void setWindowSamples(int newWindowSamples) noexcept
+    {
+        newWindowSamples = juce::jlimit(1, (int) historyMask, newWindowSamples);
+        if (newWindowSamples != windowSamples)
+        {
+            windowSamples = newWindowSamples;
+            clearHistory();
+        }
+    }
+
+    // Constant-skirt band-pass (RBJ), normalised by a0
+    void setBand(int band, double sampleRate, float freq, float q) noexcept
+    {
+        if (sampleRate <= 0.0)
+            return;
+
+        const double w0 = 2.0 * juce::MathConstants<double>::pi * freq / sampleRate;
+        const double alpha = std::sin(w0) / (2.0 * q);
+        const double a0 = 1.0 + alpha;
+
+        b0[band] = alpha / a0;
+        b1[band] = 0.0;
+        b2[band] = -alpha / a0;
+        a1[band] = -2.0 * std::cos(w0) / a0;
+        a2[band] = (1.0 - alpha) / a0;
+    }
+
+    // Linear threshold; unrouted bands never reach theirs (no branch in the lane loop)
+    void setThreshold(int band, float thresholdGain, bool routedToTrigger) noexcept
+    {
+        threshold[band] = routedToTrigger ? thresholdGain : std::numeric_limits<float>::max();
+    }
+
+    void setCeiling(float ceilingGain) noexcept
+    {
+        ceiling = ceilingGain;
+        ceilingOpen = ceilingGain >= 0.99f;
+    }
+
+    void setReleaseCoefficient(float newCoefficient) noexcept { release = newCoefficient; }
+
+    // True while any routed band is still above its threshold (it could still trigger)
+    bool isAboveThreshold() const noexcept
+    {
+        bool above = false;
+        for (int b = 0; b < maxBands; ++b)
+            above = above || envelope[b] > threshold[b];
+        return above;
+    }
+
+    // Filters the mono key (left + right) / 2 through every band. Writes band 0's
+    // filtered signal and envelope (scaled by scale[i]) plus the trigger gate:
+    // 1.0 where any routed band is above its threshold and below the ceiling.
+    template <typename SampleType>
+    void process(const SampleType* keyLeft, const SampleType* keyRight, const float* scale,
+                 float* detectorOut, float* envelopeOut, float* triggerOut, int numSamples) noexcept
+    {
+        jassert (law == Law::peak || ! history.empty());  // prepare() before the windowed laws
+
+        switch (law)
+        {
+            case Law::rms:      processBands<Law::rms>(keyLeft, keyRight, scale, detectorOut, envelopeOut, triggerOut, numSamples); break;
+            case Law::peakHold: processBands<Law::peakHold>(keyLeft, keyRight, scale, detectorOut, envelopeOut, triggerOut, numSamples); break;
+            case Law::hybrid:   processBands<Law::hybrid>(keyLeft, keyRight, scale, detectorOut, envelopeOut, triggerOut, numSamples); break;
+            case Law::peak:
+            default:            processBands<Law::peak>(keyLeft, keyRight, scale, detectorOut, envelopeOut, triggerOut, numSamples); break;
+        }
+    }
+
+private:
+    static constexpr bool usesRms(Law l) noexcept { return l == Law::rms || l == Law::hybrid; }
+    static constexpr bool usesHold(Law l) noexcept { return l == Law::peakHold || l == Law::hybrid; }
+
+    void clearHistory() noexcept
+    {
+        std::fill(history.begin(), history.end(), 0.0f);
+        for (int b = 0; b < maxBands; ++b)
+        {
+            sumOfSquares[b] = 0.0;
+            dequeHead[b] = dequeTail[b] = 0;
+        }
+        sampleIndex = 0;
+    }
+
+    // Per-sample loop specialised on the detector law
+    template <Law L, typename SampleType>
+    void processBands(const SampleType* keyLeft, const SampleType* keyRight, const float* scale,
+                      float* detectorOut, float* envelopeOut, float* triggerOut, int numSamples) noexcept
+    {
+        alignas(32) SampleType c0[maxBands], c1[maxBands], c2[maxBands], d1[maxBands], d2[maxBands];
+        alignas(32) SampleType s1[maxBands], s2[maxBands];
+        alignas(32) float rectified[maxBands];
+        alignas(32) float level[maxBands];
+        const auto window = (juce::uint32) windowSamples;
+        const float inverseWindow = 1.0f / (float) windowSamples;
+
+        for (int b = 0; b < maxBands; ++b)
+        {
+            c0[b] = (SampleType) b0[b]; c1[b] = (SampleType) b1[b]; c2[b] = (SampleType) b2[b];
+            d1[b] = (SampleType) a1[b]; d2[b] = (SampleType) a2[b];
+            s1[b] = (SampleType) y1[b]; s2[b] = (SampleType) y2[b];
+        }
+
+        auto x1 = (SampleType) inputX1, x2 = (SampleType) inputX2;
+        const float ceilingGain = ceilingOpen ? std::numeric_limits<float>::max() : ceiling;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType in = (keyLeft[i] + keyRight[i]) * (SampleType) 0.5;
+
+            // Biquads (the input history is shared, the output history is per band)
+            for (int b = 0; b < maxBands; ++b)
+            {
+                const SampleType out = c0[b] * in + c1[b] * x1 + c2[b] * x2 - d1[b] * s1[b] - d2[b] * s2[b];
+                s2[b] = s1[b];
+                s1[b] = out;
+                rectified[b] = std::abs((float) out) * scale[i];
+            }
+            x2 = x1;
+            x1 = in;
+
+            // Detector law -> level
+            if constexpr (L == Law::peak)
+            {
+                for (int b = 0; b < maxBands; ++b)
+                    level[b] = rectified[b];
+            }
+            else
+            {
+                float* newest = history.data() + (size_t) (sampleIndex & historyMask) * maxBands;
+                const float* oldest = history.data() + (size_t) ((sampleIndex - window) & historyMask) * maxBands;
+
+                // Running sum of squares: add the newest sample, drop the one leaving the window
+                if constexpr (usesRms(L))
+                {
+                    for (int b = 0; b < maxBands; ++b)
+                    {
+                        sumOfSquares[b] += (double) rectified[b] * rectified[b] - (double) oldest[b] * oldest[b];
+                        level[b] = std::sqrt(juce::jmax(0.0f, (float) sumOfSquares[b] * inverseWindow));
+                    }
+                }
+
+                for (int b = 0; b < maxBands; ++b)
+                    newest[b] = rectified[b];
+
+                // Running maximum: the deque keeps decreasing values, so its front is the
+                // window maximum; each sample is pushed and popped at most once
+                if constexpr (usesHold(L))
+                {
+                    for (int b = 0; b < maxBands; ++b)
+                    {
+                        auto* indices = dequeIndices.data() + (size_t) b * (historyMask + 1);
+                        auto valueAt = [&] (juce::uint32 index) { return history[(size_t) (index & historyMask) * maxBands + (size_t) b]; };
+
+                        while (dequeTail[b] != dequeHead[b] && valueAt(indices[(dequeTail[b] - 1) & historyMask]) <= rectified[b])
+                            --dequeTail[b];
+
+                        indices[dequeTail[b]++ & historyMask] = sampleIndex;
+
+                        while (sampleIndex - indices[dequeHead[b] & historyMask] >= window)
+                            ++dequeHead[b];
+
+                        const float hold = valueAt(indices[dequeHead[b] & historyMask]);
+                        level[b] = (L == Law::hybrid) ? 0.5f * (level[b] + hold) : hold;
+                    }
+                }
+
+                ++sampleIndex;
+            }
+
+            // Instant attack, one-pole release: the release step never drops below the
+            // input, so max() picks the attack exactly when the input is above the envelope
+            float gate = 0.0f;
+            for (int b = 0; b < maxBands; ++b)
+            {
+                envelope[b] = juce::jmax(level[b], envelope[b] * release + level[b] * (1.0f - release));
+                gate = juce::jmax(gate, (envelope[b] > threshold[b] && envelope[b] < ceilingGain) ? 1.0f : 0.0f);
+            }
+
+            detectorOut[i] = (float) s1[0];
+            envelopeOut[i] = envelope[0];
+            triggerOut[i] = gate;
+        }
+
+        for (int b = 0; b < maxBands; ++b)
+        {
+            y1[b] = s1[b];
+            y2[b] = s2[b];
+        }
+        inputX1 = x1;
+        inputX2 = x2;
+    }
+
+    alignas(32) double b0[maxBands] {}, b1[maxBands] {}, b2[maxBands] {}, a1[maxBands] {}, a2[maxBands] {};
+    alignas(32) double y1[maxBands], y2[maxBands];
+    alignas(32) float envelope[maxBands];
+    alignas(32) float threshold[maxBands] { 1.0f, 1.0f, 1.0f, 1.0f };
+    double inputX1 = 0.0, inputX2 = 0.0;
+    float ceiling = 1.0f;
+    bool ceilingOpen = true;
+    float release = 0.0f;
+
+    // Sliding-window laws: rectified history (interleaved by band) and one deque of
+    // sample indices per band
+    Law law = Law::peak;
+    std::vector<float> history;
+    std::vector<juce::uint32> dequeIndices;
+    double sumOfSquares[maxBands] {};
+    juce::uint32 dequeHead[maxBands] {}, dequeTail[maxBands] {};
+    juce::uint32 historyMask = 1;
+    juce::uint32 sampleIndex = 0;
+    int windowSamples = 1;
+};
@@ -9,15 +9,17 @@
 #include "PluginProcessor.h"
 
 EnvelopeView::EnvelopeView(NewProjectAudioProcessor& p)
-    : processor(p)
+    : processor(p),
+      scopeTap(p.telemetryTaps, TelemetryTaps::scope),
+      triggerTap(p.telemetryTaps, TelemetryTaps::triggerEvents),
+      detectorHistory((size_t) historySize, 0.0f),
+      outputHistory((size_t) historySize, 0.0f)
 {
-    // Initialize frozen waveform with zeros
-    for (auto& point : frozenWaveform)
-    {
-        point.detectorInput = 0.0f;
-        point.synthOutput = 0.0f;
-        point.finalOutput = 0.0f;
-    }
+    static_assert (historySize % ScopeCaptureRing::blockSize == 0, "history must hold whole ring blocks");
+
+    // Frozen waveform storage (empty until the first trigger)
+    detectorSnapshot.setCapacity(waveformSize);
+    outputSnapshot.setCapacity(waveformSize);
 
     // Start 60Hz timer
     startTimerHz(60);
@@ -109,16 +111,8 @@ void EnvelopeView::paint(juce::Graphics& g)
     // Use RMS-based decimation for smooth continuous lines
     int screenWidth = (int)width;
 
-    // Find actual valid sample count (dynamic during scrolling)
-    int validSamples = 0;
-    for (int i = waveformSize - 1; i >= 0; --i)
-    {
-        if (frozenWaveform[i].detectorInput != 0.0f || frozenWaveform[i].finalOutput != 0.0f)
-        {
-            validSamples = i + 1;
-            break;
-        }
-    }
+    // Valid sample count (grows while scrolling)
+    int validSamples = detectorSnapshot.getNumSamples();
 
     if (validSamples == 0)
     {
@@ -155,18 +149,10 @@ void EnvelopeView::paint(juce::Graphics& g)
 
         if (startSample >= validSamples) break;
 
-        // Find peak value in this pixel range (for envelope follower)
-        float detPeak = 0.0f;
-        float outPeak = 0.0f;
-
-        for (int i = startSample; i < endSample; ++i)
-        {
-            float detAbs = std::abs(frozenWaveform[i].detectorInput);
-            float outAbs = std::abs(frozenWaveform[i].finalOutput);
-
-            if (detAbs > detPeak) detPeak = detAbs;
-            if (outAbs > outPeak) outPeak = outAbs;
-        }
+        // Peak value in this pixel range (for envelope follower), read from the min/max
+        // levels: bounded cost per pixel whatever the samples-per-pixel ratio
+        float detPeak = detectorSnapshot.getRange(startSample, endSample).getPeak() * autoScaleFactor;
+        float outPeak = outputSnapshot.getRange(startSample, endSample).getPeak() * autoScaleFactor;
 
         // Envelope follower: fast attack, slow release (like analog peak detector)
         if (detPeak > detEnvelope)
@@ -218,6 +204,18 @@ void EnvelopeView::paint(juce::Graphics& g)
     g.setColour(outputColour);  // 100% alpha (full brightness)
     g.strokePath(outputPath, juce::PathStrokeType(2.0f));
 
+    // Hit markers: every trigger inside the snapshot at its exact sample (rolls included)
+    g.setColour(triggerHighlight.withAlpha(0.6f));
+    for (int h = 0; h < numSnapshotHits; ++h)
+    {
+        const auto offset = snapshotHits[(size_t) h] - snapshotStart;
+        if (offset < validSamples)
+        {
+            const float x = (float) (offset / samplesPerPixel);
+            g.drawLine(x, 0.0f, x, height, 1.0f);
+        }
+    }
+
     // === X-Axis Time Highlight (Enforcer style) ===
     // Fill the area under the output waveform curve during enhancement period
     // This creates a visual "integral" effect showing low-frequency enhancement duration
@@ -314,108 +312,156 @@ void EnvelopeView::resized()
 
 void EnvelopeView::timerCallback()
 {
+    // Also catches an ancestor being hidden, which sends this view no callback
+    updateSubscriptions();
+    if (!scopeTap.isActive())
+        return;
+
     updateFromProcessor();
     repaint();
 }
 
-void EnvelopeView::updateFromProcessor()
+void EnvelopeView::visibilityChanged()
 {
-    // Detect trigger state change (rising edge)
-    bool currentTriggerState = processor.isTriggeredUI.load();
+    updateSubscriptions();
+}
 
-    if (currentTriggerState && !lastTriggerState)
-    {
-        // === NEW TRIGGER DETECTED ===
-        // Record trigger moment and start real-time scrolling
-        triggerScopePos = processor.dualScopeWritePos.load();
-        triggerTime = 0;
-        isScrolling = true;
+void EnvelopeView::parentHierarchyChanged()
+{
+    updateSubscriptions();
+}
 
-        // Calculate maximum display window based on amplitude envelope
-        double sampleRate = processor.atomicSampleRate.load();
-        float aAttMs = processor.apvts->getRawParameterValue("A_ATT")->load();
-        float aDecMs = processor.apvts->getRawParameterValue("A_DEC")->load();
-        int preTriggerSamples = (int)(sampleRate * 0.010);  // 10ms pre-trigger
-        int aAttSamples = (int)(sampleRate * aAttMs / 1000.0);
-        int aDecSamples = (int)(sampleRate * aDecMs / 1000.0);
+void EnvelopeView::updateSubscriptions()
+{
+    // While unsubscribed the scope stream simply pauses, so the history stays aligned
+    // with the stream indices when capture resumes
+    const bool showing = isShowing();
+    scopeTap.setActive(showing);
+    triggerTap.setActive(showing);
+}
+
+void EnvelopeView::pullScopeBlocks()
+{
+    const auto& ring = processor.scopeRing;
+    const auto published = ring.getNumPublished();
+
+    // Fell behind by more than the ring holds: resume at the oldest block still there
+    // (history indices stay equal to stream indices, so event timestamps still line up)
+    if (published - nextScopeBlock > (juce::uint64) ScopeCaptureRing::numBlocks)
+    {
+        nextScopeBlock = published - (juce::uint64) ScopeCaptureRing::numBlocks;
+        historyEnd = (juce::int64) nextScopeBlock * ScopeCaptureRing::blockSize;
+    }
 
-        maxDisplaySamples = preTriggerSamples + aAttSamples + aDecSamples;
-        maxDisplaySamples = std::min(maxDisplaySamples, waveformSize);
+    for (; nextScopeBlock < published; ++nextScopeBlock)
+    {
+        const auto offset = (size_t) (historyEnd & (historySize - 1));
+        float* detectorDest = detectorHistory.data() + offset;
+        float* outputDest = outputHistory.data() + offset;
 
-        // Clear waveform buffer
-        for (auto& point : frozenWaveform)
+        // Overwritten while copying -> a silent gap rather than a torn block
+        if (!ring.read(nextScopeBlock, detectorDest, outputDest))
         {
-            point.detectorInput = 0.0f;
-            point.synthOutput = 0.0f;
-            point.finalOutput = 0.0f;
+            std::fill(detectorDest, detectorDest + ScopeCaptureRing::blockSize, 0.0f);
+            std::fill(outputDest, outputDest + ScopeCaptureRing::blockSize, 0.0f);
         }
 
-        hasValidSnapshot = true;
+        historyEnd += ScopeCaptureRing::blockSize;
     }
+}
 
-    // === REAL-TIME SCROLLING UPDATE ===
-    if (isScrolling)
-    {
-        int currentScopePos = processor.dualScopeWritePos.load();
-        int scopeSize = processor.dualScopeBufferSize;
+void EnvelopeView::pullTriggerEvents()
+{
+    TriggerEvent events[32];
 
-        // Calculate how many samples elapsed since trigger
-        int elapsedSamples = (currentScopePos - triggerScopePos + scopeSize) % scopeSize;
+    while (const int numEvents = processor.triggerEvents.pop(events, (int) std::size(events)))
+    {
+        for (int e = 0; e < numEvents; ++e)
+        {
+            const auto position = events[e].position;
 
-        // Include pre-trigger (10ms before trigger)
-        double sampleRate = processor.atomicSampleRate.load();
-        int preTriggerSamples = (int)(sampleRate * 0.010);
-        int totalSamples = elapsedSamples + preTriggerSamples;
+            // A hit after the snapshot has completed starts a new one; hits while it is
+            // still scrolling (rolls) are marked inside it
+            if (!isScrolling)
+                startSnapshot(position);
 
-        // Clamp to max display window
-        if (totalSamples > maxDisplaySamples)
-        {
-            totalSamples = maxDisplaySamples;
-            isScrolling = false;  // Stop scrolling when complete
+            if (position >= snapshotStart && position - snapshotStart < maxDisplaySamples
+                && numSnapshotHits < maxSnapshotHits)
+                snapshotHits[(size_t) numSnapshotHits++] = position;
         }
+    }
+}
 
-        // Read from two independent buffers
-        const float* detectorData = processor.detectorScopeBuffer.getReadPointer(0);
-        const float* outputData = processor.outputScopeBuffer.getReadPointer(0);
+void EnvelopeView::startSnapshot(juce::int64 triggerPosition)
+{
+    // === NEW TRIGGER ===
+    // Align the snapshot to the exact trigger sample and start real-time scrolling
+    double sampleRate = processor.atomicSampleRate.load();
+    int preTriggerSamples = (int)(sampleRate * 0.010);  // 10ms pre-trigger
+    snapshotStart = triggerPosition - preTriggerSamples;
+    isScrolling = true;
+
+    // Calculate maximum display window based on amplitude envelope
+    float aAttMs = processor.apvts->getRawParameterValue("A_ATT")->load();
+    float aDecMs = processor.apvts->getRawParameterValue("A_DEC")->load();
+    int aAttSamples = (int)(sampleRate * aAttMs / 1000.0);
+    int aDecSamples = (int)(sampleRate * aDecMs / 1000.0);
+
+    maxDisplaySamples = preTriggerSamples + aAttSamples + aDecSamples;
+    maxDisplaySamples = std::min(maxDisplaySamples, waveformSize);
+
+    // Start a new snapshot
+    detectorSnapshot.clear();
+    outputSnapshot.clear();
+    numSnapshotHits = 0;
+    hasValidSnapshot = true;
+}
 
-        // === Auto-scale: find peak in current visible range ===
-        float maxPeak = 0.0f;
-        for (int i = 0; i < totalSamples; ++i)
-        {
-            int readIndex = (triggerScopePos - preTriggerSamples + i + scopeSize) % scopeSize;
-            float detSample = std::abs(detectorData[readIndex]);
-            float outSample = std::abs(outputData[readIndex]);
-            if (detSample > maxPeak) maxPeak = detSample;
-            if (outSample > maxPeak) maxPeak = outSample;
-        }
+void EnvelopeView::updateFromProcessor()
+{
+    // Consume only the blocks and trigger events that arrived since the last frame
+    pullScopeBlocks();
+    pullTriggerEvents();
 
-        // Calculate auto-scale factor
-        const float targetPeak = 0.9f;
-        if (maxPeak > 0.0001f)
-            autoScaleFactor = targetPeak / maxPeak;
-        else
-            autoScaleFactor = 1.0f;
+    // === REAL-TIME SCROLLING UPDATE ===
+    if (isScrolling)
+    {
+        // Samples captured from 10ms before the trigger up to now, clamped to the window
+        const juce::int64 windowStart = snapshotStart;
+        const int totalSamples = (int) juce::jlimit<juce::int64>(0, maxDisplaySamples, historyEnd - windowStart);
 
-        // === Read and display waveform from trigger to current ===
-        for (int i = 0; i < totalSamples; ++i)
+        if (totalSamples >= maxDisplaySamples)
+            isScrolling = false;  // Stop scrolling when complete
+
+        // Append only the samples that arrived since the last frame (contiguous history runs)
+        for (int i = detectorSnapshot.getNumSamples(); i < totalSamples;)
         {
-            int readIndex = (triggerScopePos - preTriggerSamples + i + scopeSize) % scopeSize;
+            const juce::int64 position = windowStart + i;
+            const int readIndex = (int) (position & (historySize - 1));
 
-            frozenWaveform[i].detectorInput = detectorData[readIndex] * autoScaleFactor;
-            frozenWaveform[i].synthOutput = 0.0f;
-            frozenWaveform[i].finalOutput = outputData[readIndex] * autoScaleFactor;
-        }
+            // Before the captured stream, or already overwritten -> silence
+            if (position < 0 || historyEnd - position > historySize)
+            {
+                const float silence = 0.0f;
+                detectorSnapshot.append(&silence, 1);
+                outputSnapshot.append(&silence, 1);
+                ++i;
+                continue;
+            }
 
-        // Clear remaining samples
-        for (int i = totalSamples; i < waveformSize; ++i)
-        {
-            frozenWaveform[i].detectorInput = 0.0f;
-            frozenWaveform[i].synthOutput = 0.0f;
-            frozenWaveform[i].finalOutput = 0.0f;
+            const int run = std::min(totalSamples - i, historySize - readIndex);
+            detectorSnapshot.append(detectorHistory.data() + readIndex, run);
+            outputSnapshot.append(outputHistory.data() + readIndex, run);
+            i += run;
         }
-    }
 
-    lastTriggerState = currentTriggerState;
+        // Auto-scale from the snapshot peak (applied when painting)
+        const int numSnapshotSamples = detectorSnapshot.getNumSamples();
+        const float maxPeak = std::max(detectorSnapshot.getRange(0, numSnapshotSamples).getPeak(),
+                                       outputSnapshot.getRange(0, numSnapshotSamples).getPeak());
+        const float targetPeak = 0.9f;
+        autoScaleFactor = maxPeak > 0.0001f ? targetPeak / maxPeak : 1.0f;
+    }
 }
 
 void EnvelopeView::setThemeColors(juce::Colour accent, juce::Colour panel)
@@ -433,17 +479,17 @@ void EnvelopeView::setThemeColors(juce::Colour accent, juce::Colour panel)
 void EnvelopeView::clearDisplay()
 {
     // Clear frozen waveform
-    for (auto& point : frozenWaveform)
-    {
-        point.detectorInput = 0.0f;
-        point.synthOutput = 0.0f;
-        point.finalOutput = 0.0f;
-    }
+    detectorSnapshot.clear();
+    outputSnapshot.clear();
+
+    // Forget the captured history too (pre-trigger samples start from silence)
+    std::fill(detectorHistory.begin(), detectorHistory.end(), 0.0f);
+    std::fill(outputHistory.begin(), outputHistory.end(), 0.0f);
 
     // Reset state
     hasValidSnapshot = false;
     isScrolling = false;
-    lastTriggerState = false;
+    numSnapshotHits = 0;
 
     repaint();
 }
@@ -8,26 +8,12 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "MinMaxPyramid.h"
+#include "TelemetryTaps.h"
 
 // Forward declaration
 class NewProjectAudioProcessor;
 
-// Keep EnvelopeDataPoint structure for backward compatibility with processor
-struct EnvelopeDataPoint
-{
-    float detector = 0.0f;     // Detector envelope (linear 0.0-1.0+)
-    float synthesizer = 0.0f;  // Synthesizer amplitude envelope
-    float output = 0.0f;       // Output envelope (computed from final buffer)
-};
-
-// Waveform data structure for frozen display
-struct WaveformSnapshot
-{
-    float detectorInput = 0.0f;    // Detector input signal (post-filter)
-    float synthOutput = 0.0f;      // Synthesizer output (generated sub)
-    float finalOutput = 0.0f;      // Final mixed output
-};
-
 //==============================================================================
 class EnvelopeView : public juce::Component,
                      public juce::Timer
@@ -39,6 +25,8 @@ public:
     void paint(juce::Graphics& g) override;
     void resized() override;
     void timerCallback() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
 
     // Update waveform snapshot from processor
     void updateFromProcessor();
@@ -52,23 +40,39 @@ public:
 private:
     NewProjectAudioProcessor& processor;
 
+    // Scope + trigger streams are captured only while this view is showing
+    TelemetryTaps::Subscription scopeTap, triggerTap;
+    void updateSubscriptions();
+
     // Frozen waveform snapshot (captured on trigger)
     // V19.3: Extended to support long amplitude envelopes (up to 0.5s @ 48kHz)
     static constexpr int waveformSize = 24000;
-    std::array<WaveformSnapshot, waveformSize> frozenWaveform;
+    // Raw samples (unscaled) with min/max levels, appended as blocks arrive
+    MinMaxPyramid detectorSnapshot;    // Detector input signal (post-filter)
+    MinMaxPyramid outputSnapshot;      // Final mixed output
     bool hasValidSnapshot = false;
 
     // Auto-scale factor (calculated from peak values)
     float autoScaleFactor = 1.0f;
 
+    // Local copy of the scope stream, fed only with ring blocks not seen yet
+    static constexpr int historySize = 32768;  // Power of two, whole ring blocks
+    std::vector<float> detectorHistory, outputHistory;
+    juce::int64 historyEnd = 0;        // Stream index after the newest consumed sample
+    juce::uint64 nextScopeBlock = 0;   // Next ring block to consume
+    void pullScopeBlocks();
+
     // Real-time scrolling state
-    int triggerScopePos = 0;           // scopeWritePos when triggered
-    int64_t triggerTime = 0;           // Timestamp when triggered (in samples)
+    juce::int64 snapshotStart = 0;     // Stream index of the first snapshot sample (10ms pre-trigger)
     bool isScrolling = false;          // Currently scrolling after trigger
     int maxDisplaySamples = 0;         // Maximum samples to display (A_ATT + A_DEC)
 
-    // Trigger detection for freeze mode
-    bool lastTriggerState = false;
+    // Hits inside the current snapshot (stream indices from the trigger event queue)
+    static constexpr int maxSnapshotHits = 64;
+    std::array<juce::int64, maxSnapshotHits> snapshotHits {};
+    int numSnapshotHits = 0;
+    void pullTriggerEvents();
+    void startSnapshot(juce::int64 triggerPosition);
 
     // Visual scaling helpers
     inline float mapToVisualY(float sample, float height) const
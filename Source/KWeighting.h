@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+    KWeighting.h (SPLENTA V19.6 - 20261016.01)
+    ITU-R BS.1770 K-Weighting Pre-Filter for the AGM
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Two-stage K-weighting (high shelf + RLB high-pass) for up to two channels.
+// Writes the per-sample K-weighted power summed over channels (BS.1770 channel
+// weights are 1.0 for left/right), ready for a running loudness integrator.
+// Coefficients are derived for any sample rate from the analogue prototypes.
+class KWeighting
+{
+public:
+    static constexpr int maxChannels = 2;
+
+    void prepare(double sampleRate) noexcept
+    {
+        // Stage 1: high shelf (+4 dB above ~1.7 kHz, head diffraction)
+        {
+            const double f0 = 1681.974450955533;
+            const double gainDb = 3.999843853973347;
+            const double q = 0.7071752369554196;
+
+            const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+            const double vh = std::pow(10.0, gainDb / 20.0);
+            const double vb = std::pow(vh, 0.4996667741545416);
+            const double a0 = 1.0 + k / q + k * k;
+
+            stages[0] = { (vh + vb * k / q + k * k) / a0,
+                          2.0 * (k * k - vh) / a0,
+                          (vh - vb * k / q + k * k) / a0,
+                          2.0 * (k * k - 1.0) / a0,
+                          (1.0 - k / q + k * k) / a0 };
+        }
+
+        // Stage 2: RLB high-pass (~38 Hz)
+        {
+            const double f0 = 38.13547087602444;
+            const double q = 0.5003270373238773;
+
+            const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+            const double a0 = 1.0 + k / q + k * k;
+
+            stages[1] = { 1.0, -2.0, 1.0,
+                          2.0 * (k * k - 1.0) / a0,
+                          (1.0 - k / q + k * k) / a0 };
+        }
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& channel : state)
+            for (auto& stage : channel)
+                stage = {};
+    }
+
+    // right may be nullptr (mono)
+    template <typename SampleType>
+    void process(const SampleType* left, const SampleType* right, float* power, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            power[i] = square(filter(0, (double) left[i]));
+
+        if (right != nullptr)
+            for (int i = 0; i < numSamples; ++i)
+                power[i] += square(filter(1, (double) right[i]));
+    }
+
+private:
+    struct Coefficients { double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0; };
+    struct State { double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0; };
+
+    static float square(double x) noexcept { return (float) (x * x); }
+
+    // Both stages, direct form I (state in double: the RLB pole sits very close to 1)
+    double filter(int channel, double x) noexcept
+    {
+        for (int s = 0; s < 2; ++s)
+        {
+            const auto& c = stages[s];
+            auto& z = state[channel][s];
+            const double y = c.b0 * x + c.b1 * z.x1 + c.b2 * z.x2 - c.a1 * z.y1 - c.a2 * z.y2;
+            z.x2 = z.x1; z.x1 = x;
+            z.y2 = z.y1; z.y1 = y;
+            x = y;
+        }
+        return x;
+    }
+
+    Coefficients stages[2];
+    State state[maxChannels][2];
+};
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+    LookaheadDelay.h (SPLENTA V19.6 - 20261016.01)
+    Preallocated Dry-Path Delay for the Lookahead Detector
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Multi-channel ring buffer that delays a block in place by a whole number of
+// samples. Storage is sized once in prepare() (max delay + max block, rounded
+// up to a power of two), so changing the delay never allocates. Each block is
+// two wrapped copies in and two out, with no per-sample index arithmetic.
+//
+// With a fade length, a delay change crossfades from the old read point to the
+// new one instead of jumping (no click, skip or repeat under automation); a
+// change made during a fade starts when that fade ends.
+template <typename SampleType>
+class LookaheadDelay
+{
+public:
+    void prepare(int numChannels, int maxDelaySamples, int maxBlockSize, int fadeSamples = 0)
+    {
+        const int capacity = juce::nextPowerOfTwo(juce::jmax(1, maxDelaySamples + maxBlockSize));
+        buffer.setSize(juce::jmax(1, numChannels), capacity);
+        mask = capacity - 1;
+        maxDelay = maxDelaySamples;
+        fadeLength = juce::jmax(0, fadeSamples);
+        targetDelay = juce::jmin(targetDelay, maxDelay);
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        buffer.clear();
+        writePos = 0;
+
+        // Nothing to fade from in an empty line
+        delaySamples = previousDelay = targetDelay;
+        fadePosition = fadeLength;
+    }
+
+    void setDelay(int newDelaySamples) noexcept
+    {
+        targetDelay = juce::jlimit(0, maxDelay, newDelaySamples);
+        if (!isFading())
+            startFade();
+    }
+
+    int getDelay() const noexcept { return targetDelay; }
+
+    // Delay one channel in place. Call for every channel with the same numSamples,
+    // then advance() once per block.
+    void process(int channel, SampleType* data, int numSamples) noexcept
+    {
+        jassert (numSamples + delaySamples <= mask + 1);
+        auto* ring = buffer.getWritePointer(channel);
+
+        copyIn(ring, writePos, data, numSamples);
+
+        if (!isFading())
+        {
+            copyOut(ring, (writePos - delaySamples) & mask, data, numSamples);
+            return;
+        }
+
+        // Linear crossfade from the previous read point (per sample, only while fading)
+        const auto step = (SampleType) 1 / (SampleType) fadeLength;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto older = ring[(writePos - previousDelay + i) & mask];
+            const auto newer = ring[(writePos - delaySamples + i) & mask];
+            const auto gain = juce::jmin((SampleType) 1, (SampleType) (fadePosition + i + 1) * step);
+            data[i] = older + (newer - older) * gain;
+        }
+    }
+
+    // Feed one channel without reading it back (keeps an unused line current)
+    void write(int channel, const SampleType* data, int numSamples) noexcept
+    {
+        jassert (numSamples + delaySamples <= mask + 1);
+        copyIn(buffer.getWritePointer(channel), writePos, data, numSamples);
+    }
+
+    void advance(int numSamples) noexcept
+    {
+        writePos = (writePos + numSamples) & mask;
+
+        if (isFading())
+        {
+            fadePosition += numSamples;
+            if (!isFading())
+                startFade();  // A change queued during the fade
+        }
+    }
+
+private:
+    bool isFading() const noexcept { return fadePosition < fadeLength; }
+
+    void startFade() noexcept
+    {
+        if (targetDelay == delaySamples)
+            return;
+
+        previousDelay = delaySamples;
+        delaySamples = targetDelay;
+        fadePosition = 0;
+    }
+
+    void copyIn(SampleType* ring, int pos, const SampleType* src, int numSamples) const noexcept
+    {
+        const int first = juce::jmin(numSamples, mask + 1 - pos);
+        juce::FloatVectorOperations::copy(ring + pos, src, first);
+        juce::FloatVectorOperations::copy(ring, src + first, numSamples - first);
+    }
+
+    void copyOut(const SampleType* ring, int pos, SampleType* dest, int numSamples) const noexcept
+    {
+        const int first = juce::jmin(numSamples, mask + 1 - pos);
+        juce::FloatVectorOperations::copy(dest, ring + pos, first);
+        juce::FloatVectorOperations::copy(dest + first, ring, numSamples - first);
+    }
+
+    juce::AudioBuffer<SampleType> buffer;
+    int mask = 0;
+    int writePos = 0;
+    int maxDelay = 0;
+    int delaySamples = 0;   // Read point (the new one while fading)
+    int previousDelay = 0;  // Read point faded out
+    int targetDelay = 0;    // Latest setDelay()
+    int fadeLength = 0;
+    int fadePosition = 0;
+};
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+    MinMaxPyramid.h (SPLENTA V19.6 - 20261016.01)
+    Multi-Resolution Min/Max Summary for Waveform Display
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Append-only waveform with min/max levels over 16, 64, 256 and 1024-sample
+// buckets. Every appended sample updates its bucket on each level (the newest
+// bucket of a level is partial until it fills), so the summary is always current.
+//
+// getRange() covers any span with the coarsest buckets that fit inside it and
+// finer buckets / raw samples only at the two unaligned edges: the cost per query
+// is bounded by the level ratio, not the span, so one query per pixel keeps a
+// paint O(pixels) at any zoom.
+class MinMaxPyramid
+{
+public:
+    static constexpr int numLevels = 4;
+    static constexpr int baseShift = 4;     // Level 0 buckets: 16 samples
+    static constexpr int levelShift = 2;    // Each level 4x coarser
+
+    struct Range
+    {
+        float min = std::numeric_limits<float>::max();
+        float max = std::numeric_limits<float>::lowest();
+
+        void add(float value) noexcept { min = juce::jmin(min, value); max = juce::jmax(max, value); }
+        void add(const Range& other) noexcept { min = juce::jmin(min, other.min); max = juce::jmax(max, other.max); }
+        float getPeak() const noexcept { return max < min ? 0.0f : juce::jmax(-min, max); }
+    };
+
+    // Allocates room for capacity samples (message thread)
+    void setCapacity(int capacity)
+    {
+        samples.assign((size_t) juce::jmax(1, capacity), 0.0f);
+        for (int level = 0; level < numLevels; ++level)
+            levels[level].assign((size_t) (getNumBuckets(level) + 1), Range {});
+        numSamples = 0;
+    }
+
+    void clear() noexcept
+    {
+        for (int level = 0; level < numLevels; ++level)
+            std::fill(levels[level].begin(), levels[level].end(), Range {});
+        numSamples = 0;
+    }
+
+    int getNumSamples() const noexcept { return numSamples; }
+    int getCapacity() const noexcept { return (int) samples.size(); }
+    float getSample(int index) const noexcept { return samples[(size_t) index]; }
+
+    // Appends up to the capacity; returns the number of samples taken
+    int append(const float* source, int count) noexcept
+    {
+        count = juce::jmin(count, getCapacity() - numSamples);
+
+        for (int i = 0; i < count; ++i)
+        {
+            const float value = source[i];
+            samples[(size_t) (numSamples + i)] = value;
+
+            for (int level = 0; level < numLevels; ++level)
+                levels[level][(size_t) ((numSamples + i) >> getShift(level))].add(value);
+        }
+
+        numSamples += count;
+        return count;
+    }
+
+    // Min/max over samples [start, end), clamped to what has been appended
+    Range getRange(int start, int end) const noexcept
+    {
+        start = juce::jmax(0, start);
+        end = juce::jmin(end, numSamples);
+
+        Range range;
+        int level = -1;  // -1 = raw samples
+
+        // Climb while the next level has whole buckets inside the span, settling the
+        // unaligned edges on the current level first
+        while (level + 1 < numLevels && start < end)
+        {
+            const int bucket = 1 << getShift(level + 1);
+            const int alignedStart = (start + bucket - 1) & ~(bucket - 1);
+            const int alignedEnd = end & ~(bucket - 1);
+
+            if (alignedStart >= alignedEnd)
+                break;
+
+            accumulate(level, start, alignedStart, range);
+            accumulate(level, alignedEnd, end, range);
+            start = alignedStart;
+            end = alignedEnd;
+            ++level;
+        }
+
+        accumulate(level, start, end, range);
+        return range;
+    }
+
+private:
+    static constexpr int getShift(int level) noexcept { return baseShift + level * levelShift; }
+    int getNumBuckets(int level) const noexcept { return (int) samples.size() >> getShift(level); }
+
+    // [start, end) is aligned to the level's bucket size (any span for raw samples)
+    void accumulate(int level, int start, int end, Range& range) const noexcept
+    {
+        if (level < 0)
+        {
+            for (int i = start; i < end; ++i)
+                range.add(samples[(size_t) i]);
+            return;
+        }
+
+        const int shift = getShift(level);
+        for (int bucket = start >> shift; bucket < end >> shift; ++bucket)
+            range.add(levels[level][(size_t) bucket]);
+    }
+
+    std::vector<float> samples;
+    std::vector<Range> levels[numLevels];
+    int numSamples = 0;
+};
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+    NoiseGenerator.h (SPLENTA V19.6 - 20261016.01)
+    Per-Instance Block Noise Source for NOISE_MIX
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Allocation-free white noise in [-1, 1), one generator per plugin instance
+// (no shared juce::Random, so instances never contend on the audio thread).
+//
+// Eight independent xorshift32 lanes are stepped together; the lane loop has
+// no cross-lane dependency so it compiles to vector instructions (SIMDRegister
+// has no integer shifts). Output order is independent of block size, so a
+// fixed seed reproduces the same stream bit-for-bit.
+class NoiseGenerator
+{
+public:
+    static constexpr int numLanes = 8;
+
+    static constexpr juce::uint32 defaultSeed = 0x5EED5EEDu;
+
+    NoiseGenerator() { seed(defaultSeed); }
+
+    void seed(juce::uint32 newSeed) noexcept
+    {
+        // SplitMix32 spreads one seed over all lanes (xorshift state must be non-zero)
+        juce::uint32 z = newSeed;
+        for (auto& lane : state)
+        {
+            z += 0x9E3779B9u;
+            juce::uint32 x = z;
+            x = (x ^ (x >> 16)) * 0x85EBCA6Bu;
+            x = (x ^ (x >> 13)) * 0xC2B2AE35u;
+            x ^= x >> 16;
+            lane = (x != 0) ? x : 0x6D2B79F5u;
+        }
+
+        pending = numLanes;
+    }
+
+    void fill(float* dest, int numSamples) noexcept
+    {
+        int i = 0;
+
+        // Drain values left over from the previous call
+        while (i < numSamples && pending < numLanes)
+            dest[i++] = leftover[(size_t) pending++];
+
+        // Whole lane groups straight into the destination
+        for (; i + numLanes <= numSamples; i += numLanes)
+            generate(dest + i);
+
+        // Partial tail: generate a full group and keep the rest for next time
+        if (i < numSamples)
+        {
+            generate(leftover.data());
+            pending = 0;
+
+            while (i < numSamples)
+                dest[i++] = leftover[(size_t) pending++];
+        }
+    }
+
+private:
+    void generate(float* dest) noexcept
+    {
+        constexpr float scale = 1.0f / 2147483648.0f;  // int32 -> [-1, 1)
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            juce::uint32 x = state[(size_t) lane];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            state[(size_t) lane] = x;
+            dest[lane] = (float) (juce::int32) x * scale;
+        }
+    }
+
+    std::array<juce::uint32, numLanes> state {};
+    std::array<float, numLanes> leftover {};
+    int pending = numLanes;
+};
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+    OutputLimiter.cpp (SPLENTA V19.6 - 20261016.01)
+    Lookahead (True-)Peak Limiter for the Output Stage
+  ==============================================================================
+*/
+
+#include "OutputLimiter.h"
+
+namespace
+{
+    constexpr double lookaheadSeconds = 0.0015;
+    constexpr double releaseSeconds = 0.05;
+}
+
+void OutputLimiter::prepare(double sampleRate, int maxBlockSize)
+{
+    maxBlockSize = juce::jmax(1, maxBlockSize);
+
+    // Hann-windowed sinc phases at 1/4, 2/4 and 3/4 between samples, unity gain at DC
+    for (int k = 1; k < truePeakFactor; ++k)
+    {
+        const double fraction = (double) k / truePeakFactor;
+        double sum = 0.0;
+
+        for (int j = 0; j < tapsPerPhase; ++j)
+        {
+            const double t = (double) (j - (interpolatorDelay - 1)) - fraction;  // Offset from the interpolated point
+            const double sinc = juce::MathConstants<double>::pi * t;
+            const double window = 0.5 * (1.0 + std::cos(juce::MathConstants<double>::pi * t / interpolatorDelay));
+            const double tap = (std::sin(sinc) / sinc) * window;
+
+            phaseTaps[k - 1][j] = (float) tap;
+            sum += tap;
+        }
+
+        for (auto& tap : phaseTaps[k - 1])
+            tap = (float) (tap / sum);
+    }
+
+    for (auto& channelWork : work)
+        channelWork.assign((size_t) (historySamples + maxBlockSize), 0.0f);
+
+    peak.assign((size_t) maxBlockSize, 0.0f);
+    gain.assign((size_t) maxBlockSize, 1.0f);
+
+    windowSamples = juce::jmax(1, juce::roundToInt(lookaheadSeconds * sampleRate));
+    const int ringSize = juce::nextPowerOfTwo(windowSamples + 1);
+    ringMask = (juce::uint32) ringSize - 1;
+    peakRing.assign((size_t) ringSize, 0.0f);
+    dequeIndices.assign((size_t) ringSize, 0);
+    averageRing.assign((size_t) windowSamples, 1.0f);
+
+    releaseCoeff = 1.0f - (float) std::exp(-1.0 / (releaseSeconds * sampleRate));
+
+    // Peak at input sample n - interpolatorDelay is fully limited windowSamples - 1 later
+    latencySamples = interpolatorDelay + windowSamples - 1;
+    delayFloat.prepare(maxChannels, latencySamples, maxBlockSize);
+    delayDouble.prepare(maxChannels, latencySamples, maxBlockSize);
+    delayFloat.setDelay(latencySamples);
+    delayDouble.setDelay(latencySamples);
+
+    reset();
+}
+
+void OutputLimiter::reset() noexcept
+{
+    for (auto& channelWork : work)
+        std::fill(channelWork.begin(), channelWork.end(), 0.0f);
+
+    std::fill(peakRing.begin(), peakRing.end(), 0.0f);
+    dequeHead = dequeTail = 0;
+
+    std::fill(averageRing.begin(), averageRing.end(), 1.0f);
+    averageSum = (double) averageRing.size();
+    averagePos = 0;
+    released = 1.0f;
+
+    delayFloat.reset();
+    delayDouble.reset();
+}
+
+template <bool TruePeak>
+void OutputLimiter::detectPeaks(int channel, int numSamples) noexcept
+{
+    auto& channelWork = work[channel];
+    const float* w = channelWork.data();
+
+    // Output i covers input sample i - interpolatorDelay (w[c]) and the points after it
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const int c = i + historySamples - interpolatorDelay;
+        float level = std::abs(w[c]);
+
+        if constexpr (TruePeak)
+        {
+            const float* taps = w + c - (interpolatorDelay - 1);
+            for (int k = 0; k < truePeakFactor - 1; ++k)
+            {
+                float interpolated = 0.0f;
+                for (int j = 0; j < tapsPerPhase; ++j)
+                    interpolated += phaseTaps[k][j] * taps[j];
+
+                level = juce::jmax(level, std::abs(interpolated));
+            }
+        }
+
+        peak[(size_t) i] = juce::jmax(peak[(size_t) i], level);
+    }
+
+    // Keep the newest samples as history for the next block
+    std::copy(channelWork.begin() + numSamples, channelWork.begin() + numSamples + historySamples, channelWork.begin());
+}
+
+void OutputLimiter::computeGain(int numSamples) noexcept
+{
+    const auto window = (juce::uint32) windowSamples;
+    const double inverseWindow = 1.0 / windowSamples;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Running maximum over the window: the deque keeps decreasing peaks
+        const float level = peak[(size_t) i];
+        peakRing[sampleIndex & ringMask] = level;
+
+        while (dequeTail != dequeHead && peakRing[dequeIndices[(dequeTail - 1) & ringMask] & ringMask] <= level)
+            --dequeTail;
+
+        dequeIndices[dequeTail++ & ringMask] = sampleIndex;
+
+        while (sampleIndex - dequeIndices[dequeHead & ringMask] >= window)
+            ++dequeHead;
+
+        const float windowPeak = peakRing[dequeIndices[dequeHead & ringMask] & ringMask];
+        ++sampleIndex;
+
+        // Required gain, released upwards only (never above the requirement)
+        const float required = windowPeak > ceiling ? ceiling / windowPeak : 1.0f;
+        released = juce::jmin(required, released + (1.0f - released) * releaseCoeff);
+
+        // Running average over the window smooths the attack into a ramp
+        averageSum += (double) released - (double) averageRing[(size_t) averagePos];
+        averageRing[(size_t) averagePos] = released;
+        if (++averagePos == windowSamples)
+            averagePos = 0;
+
+        gain[(size_t) i] = (float) (averageSum * inverseWindow);
+    }
+}
+
+template void OutputLimiter::detectPeaks<true>(int, int) noexcept;
+template void OutputLimiter::detectPeaks<false>(int, int) noexcept;
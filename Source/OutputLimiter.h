@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+    OutputLimiter.h (SPLENTA V19.6 - 20261016.01)
+    Lookahead (True-)Peak Limiter for the Output Stage
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LookaheadDelay.h"
+
+// Brickwall limiter at the output ceiling, replacing the per-sample clips.
+//
+// Per sample, the peak over all channels (the sample itself, or 4x interpolated
+// true peak) feeds a running maximum over the lookahead window (monotonic deque,
+// O(1) per sample). The gain that brings that maximum to the ceiling is released
+// by a one-pole that may only rise towards unity, then averaged over the same
+// window (running sum). The audio is delayed so every averaged gain sample that
+// touches a peak is at or below that peak's required gain: peaks land on the
+// ceiling without clipping and the gain never steps.
+//
+// Latency (getLatencySamples) is the lookahead plus the interpolator delay and
+// does not change when true-peak detection is toggled.
+class OutputLimiter
+{
+public:
+    static constexpr int maxChannels = 2;
+
+    void prepare(double sampleRate, int maxBlockSize);
+    void reset() noexcept;
+
+    void setCeiling(float newCeilingGain) noexcept { ceiling = newCeilingGain; }
+    void setTruePeak(bool shouldDetectTruePeak) noexcept { truePeak = shouldDetectTruePeak; }
+    int getLatencySamples() const noexcept { return latencySamples; }
+
+    // Limits (and delays) numChannels channels of numSamples <= maxBlockSize in place
+    template <typename SampleType>
+    void process(SampleType* const* channels, int numChannels, int numSamples) noexcept
+    {
+        jassert (numChannels <= maxChannels && numSamples <= (int) gain.size());
+        numChannels = juce::jmin(numChannels, maxChannels);
+
+        // 1. Peak over channels (the interpolator runs interpolatorDelay samples behind)
+        std::fill(peak.begin(), peak.begin() + numSamples, 0.0f);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* w = work[ch].data() + historySamples;
+            for (int i = 0; i < numSamples; ++i)
+                w[i] = (float) channels[ch][i];
+
+            if (truePeak)
+                detectPeaks<true>(ch, numSamples);
+            else
+                detectPeaks<false>(ch, numSamples);
+        }
+
+        // 2. Gain computer
+        computeGain(numSamples);
+
+        // 3. Delay the audio into line with the gain and apply it to every channel
+        auto& delay = getDelay<SampleType>();
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            delay.process(ch, channels[ch], numSamples);
+
+            if constexpr (std::is_same_v<SampleType, float>)
+            {
+                juce::FloatVectorOperations::multiply(channels[ch], gain.data(), numSamples);
+            }
+            else
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    channels[ch][i] *= (SampleType) gain[(size_t) i];
+            }
+        }
+        delay.advance(numSamples);
+    }
+
+private:
+    // 4x interpolator: 8 taps per phase around each sample pair (phase 0 is the sample)
+    static constexpr int truePeakFactor = 4;
+    static constexpr int interpolatorDelay = 4;
+    static constexpr int tapsPerPhase = 2 * interpolatorDelay;
+    static constexpr int historySamples = tapsPerPhase - 1;
+
+    template <bool TruePeak>
+    void detectPeaks(int channel, int numSamples) noexcept;
+    void computeGain(int numSamples) noexcept;
+
+    template <typename SampleType>
+    LookaheadDelay<SampleType>& getDelay() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>) return delayDouble;
+        else return delayFloat;
+    }
+
+    float phaseTaps[truePeakFactor - 1][tapsPerPhase] {};
+    std::vector<float> work[maxChannels];   // history + current block
+    std::vector<float> peak, gain;
+
+    // Running maximum of the peaks over the lookahead window (sample ring + index deque)
+    std::vector<float> peakRing;
+    std::vector<juce::uint32> dequeIndices;
+    juce::uint32 ringMask = 0, dequeHead = 0, dequeTail = 0, sampleIndex = 0;
+
+    // Running average of the released gain over the lookahead window
+    std::vector<float> averageRing;
+    double averageSum = 0.0;
+    int averagePos = 0;
+
+    float released = 1.0f;
+    float releaseCoeff = 0.0f;
+    float ceiling = 1.0f;
+    bool truePeak = true;
+    int windowSamples = 1;
+    int latencySamples = 0;
+
+    LookaheadDelay<float> delayFloat;
+    LookaheadDelay<double> delayDouble;
+};
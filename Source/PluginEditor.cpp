@@ -10,7 +10,7 @@
 #include <cmath>
 
 NewProjectAudioProcessorEditor::NewProjectAudioProcessorEditor (NewProjectAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p), envelopeView(p),
+    : AudioProcessorEditor (&p), audioProcessor (p), envelopeView(p), spectrumDisplay(p.spectrumAnalyser, p.telemetryTaps),
       waveformSelector(*p.apvts), splitToggle(*p.apvts), powerButton(*p.apvts), colorControl(*p.apvts), midiToggle(*p.apvts), retriggerModeSelector(p), shuffleButton(), abCompareComponent(p)
 {
     // Custom components (Batch 06) - Add BEFORE sliders to ensure on top
@@ -159,6 +159,7 @@ NewProjectAudioProcessorEditor::NewProjectAudioProcessorEditor (NewProjectAudioP
 
     addAndMakeVisible(envelopeView);
     addAndMakeVisible(energyTopology);
+    addAndMakeVisible(spectrumDisplay);  // After the topology: drawn on top of it
 
     // MIDI Virtual Keyboard setup (uses processor's keyboardState for external MIDI sync)
     virtualKeyboard.reset(new VirtualKeyboardComponent(audioProcessor.keyboardState));
@@ -237,6 +238,7 @@ void NewProjectAudioProcessorEditor::updateColors()
 
     // Update EnergyTopology colors
     energyTopology.setPalette(palette);
+    spectrumDisplay.setPalette(palette);
 
     // Update custom components (Batch 06)
     waveformSelector.setPalette(palette);
@@ -846,6 +848,7 @@ void NewProjectAudioProcessorEditor::resized()
     // Energy Topology bounds (matches paint() panel calculation)
     juce::Rectangle<int> topologyPanelArea(490, margin, 460, topPanelHeight);
     energyTopology.setBounds(topologyPanelArea.withTrimmedTop(headerHeight).reduced(4));
+    spectrumDisplay.setBounds(topologyArea.withTrimmedTop(topologyArea.getHeight() - 60));
 
     threshSlider.setBounds (20, startY, knobSize, knobSize);
     ceilingSlider.setBounds(100, startY, knobSize, knobSize);
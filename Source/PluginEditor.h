@@ -23,6 +23,7 @@
 #include "RetriggerModeSelector.h"
 #include "ShuffleButtonComponent.h"
 #include "ABCompareComponent.h"
+#include "SpectrumDisplay.h"
 
 class NewProjectAudioProcessorEditor  : public juce::AudioProcessorEditor,
                                         public juce::Timer
@@ -78,11 +79,15 @@ private:
     // Theme selector (replaces old themeBox)
     ThemeSelector themeSelector;
 
+    // Hover help for the custom toggles
+    juce::TooltipWindow tooltipWindow { this, 600 };
+
     juce::TextButton auditionButton { "" };
     std::unique_ptr<ButtonAttachment> auditionAtt;
 
     EnvelopeView envelopeView;
     EnergyTopologyComponent energyTopology;
+    SpectrumDisplay spectrumDisplay;  // FFT tap overlay along the bottom of the topology panel
     juce::Rectangle<int> envelopeArea, topologyArea;
 
     // MIDI Virtual Keyboard (uses audioProcessor.keyboardState)
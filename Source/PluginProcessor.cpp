@@ -9,13 +9,57 @@
 #include "PluginEditor.h"
 #include <cmath>
 
+namespace
+{
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+    constexpr int simdWidth = (int) SIMDFloat::size();
+
+    // Scratch channels are SIMD-aligned and padded to a whole register, so the
+    // stateless stages can run over the padded length without a scalar tail.
+    inline int getNumSIMDSamples (int numSamples) noexcept
+    {
+        return (numSamples + simdWidth - 1) & ~(simdWidth - 1);
+    }
+
+    // Writes the next numSamples values of a smoother (constant fill when settled)
+    inline void fillRamp (juce::LinearSmoothedValue<float>& smoothed, float* dest, int numSamples) noexcept
+    {
+        if (smoothed.isSmoothing())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = smoothed.getNextValue();
+        }
+        else
+        {
+            juce::FloatVectorOperations::fill(dest, smoothed.getTargetValue(), getNumSIMDSamples(numSamples));
+        }
+    }
+
+    // Float scratch (generated signals) -> host samples
+    template <typename SampleType>
+    inline void copyToHost (SampleType* dest, const float* source, int numSamples) noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            juce::FloatVectorOperations::copy(dest, source, numSamples);
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = (SampleType) source[i];
+        }
+    }
+
+    // Output ceiling at -0.01dB (computed once, not per block)
+    const float outputCeiling = juce::Decibels::decibelsToGain(-0.01f);
+}
+
 NewProjectAudioProcessor::NewProjectAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
      : AudioProcessor (BusesProperties()
                      .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-                     .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-       forwardFFT (fftOrder),
-       window (fftSize, juce::dsp::WindowingFunction<float>::hann)
+                     .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                     .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false))
 #endif
 {
     apvts.reset (new juce::AudioProcessorValueTreeState (*this, nullptr, "Parameters", createParameterLayout()));
@@ -24,10 +68,25 @@ NewProjectAudioProcessor::NewProjectAudioProcessor()
     ceilingParam  = apvts->getRawParameterValue("CEILING");
     detReleaseParam = apvts->getRawParameterValue("DET_REL");
     detScaleParam = apvts->getRawParameterValue("DET_SCALE");
+    detModeParam  = apvts->getRawParameterValue("DET_MODE");
+    detWindowParam = apvts->getRawParameterValue("DET_WIN");
     auditionParam = apvts->getRawParameterValue("AUDITION");
     
     freqParam     = apvts->getRawParameterValue("F_FREQ");
     qParam        = apvts->getRawParameterValue("F_Q");
+
+    bandThreshParams[0] = threshParam;
+    bandFreqParams[0]   = freqParam;
+    bandQParams[0]      = qParam;
+    bandTriggerParams[0] = apvts->getRawParameterValue("B1_TRIG");
+    for (int b = 1; b < DetectorBank::maxBands; ++b)
+    {
+        const juce::String prefix = "B" + juce::String(b + 1) + "_";
+        bandThreshParams[(size_t) b]  = apvts->getRawParameterValue(prefix + "THRESH");
+        bandFreqParams[(size_t) b]    = apvts->getRawParameterValue(prefix + "FREQ");
+        bandQParams[(size_t) b]       = apvts->getRawParameterValue(prefix + "Q");
+        bandTriggerParams[(size_t) b] = apvts->getRawParameterValue(prefix + "TRIG");
+    }
     
     startFreqParam= apvts->getRawParameterValue("START_FREQ");
     peakFreqParam = apvts->getRawParameterValue("PEAK_FREQ");
@@ -41,6 +100,10 @@ NewProjectAudioProcessor::NewProjectAudioProcessor()
     pDecParam     = apvts->getRawParameterValue("P_DEC");
     aAttParam     = apvts->getRawParameterValue("A_ATT");
     aDecParam     = apvts->getRawParameterValue("A_DEC");
+    envCurveParam = apvts->getRawParameterValue("ENV_CURVE");
+    lookaheadParam = apvts->getRawParameterValue("LOOKAHEAD");
+    voicesParam   = apvts->getRawParameterValue("VOICES");
+    colorOversamplingParam = apvts->getRawParameterValue("COLOR_OS");
     
     duckParam     = apvts->getRawParameterValue("DUCKING");
     duckAttParam  = apvts->getRawParameterValue("D_ATT");
@@ -50,45 +113,13 @@ NewProjectAudioProcessor::NewProjectAudioProcessor()
     wetParam      = apvts->getRawParameterValue("WET_GAIN");
     dryParam      = apvts->getRawParameterValue("DRY_MIX");
     agmParam      = apvts->getRawParameterValue("AGM_MODE");
-    clipParam     = apvts->getRawParameterValue("SOFT_CLIP");
+    truePeakParam = apvts->getRawParameterValue("TRUE_PEAK");
     bypassParam   = apvts->getRawParameterValue("BYPASS");
     midiModeParam = apvts->getRawParameterValue("MIDI_MODE");
     midiPitchParam= apvts->getRawParameterValue("MIDI_PITCH");
 
-    // Scope Buffer Init (V19.3 - Extended for long envelope display)
-    // Allocate 1 second @ 48kHz = 48000 samples to support long A_DEC times
-    scopeBuffer.setSize(1, 48000);
-    scopeBuffer.clear();
-
-    // Two independent scope buffers for detector/output comparison
-    detectorScopeBuffer.setSize(1, dualScopeBufferSize);
-    outputScopeBuffer.setSize(1, dualScopeBufferSize);
-    detectorScopeBuffer.clear();
-    outputScopeBuffer.clear();
-    dualScopeWritePos = 0;
-
-    // Peak Buffer Init
-    for (auto& peak : peakBuffer) {
-        peak.minValue = 0.0f;
-        peak.maxValue = 0.0f;
-    }
-    peakWritePos = 0;
-    peakSampleCounter = 0;
-    currentMin = 0.0f;
-    currentMax = 0.0f;
-
-    // Envelope Buffer Init
-    for (auto& point : envelopeBuffer) {
-        point.detector = 0.0f;
-        point.synthesizer = 0.0f;
-        point.output = 0.0f;
-    }
-    envSampleCounter = 0;
-    peakDetector = 0.0f;
-    peakSynthesizer = 0.0f;
-    peakOutput = 0.0f;
-
-    std::fill(fftData.begin(), fftData.end(), 0.0f);
+    // Per-instance noise seed for realtime playback
+    instanceNoiseSeed = (juce::uint32) juce::Random().nextInt();
 }
 
 NewProjectAudioProcessor::~NewProjectAudioProcessor() {}
@@ -97,7 +128,16 @@ const juce::String NewProjectAudioProcessor::getName() const { return JucePlugin
 bool NewProjectAudioProcessor::acceptsMidi() const { return true; }  // Enable MIDI input
 bool NewProjectAudioProcessor::producesMidi() const { return false; }
 bool NewProjectAudioProcessor::isMidiEffect() const { return false; }
-double NewProjectAudioProcessor::getTailLengthSeconds() const { return 0.0; }
+double NewProjectAudioProcessor::getTailLengthSeconds() const
+{
+    // After the input stops, the last hit rings out through the longer of the amp and
+    // ducking envelopes, behind the reported (dry) latency
+    const float ampMs = aAttParam->load() + aDecParam->load();
+    const float duckMs = duckAttParam->load() + duckDecParam->load();
+    const double latencySeconds = currentSampleRate > 0.0 ? getLatencySamples() / currentSampleRate : 0.0;
+    return juce::jmax(ampMs, duckMs) * 0.001 + latencySeconds;
+}
+
 int NewProjectAudioProcessor::getNumPrograms() { return 1; }
 int NewProjectAudioProcessor::getCurrentProgram() { return 0; }
 void NewProjectAudioProcessor::setCurrentProgram (int index) {}
@@ -108,8 +148,54 @@ void NewProjectAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
 {
     currentSampleRate = sampleRate;
     atomicSampleRate.store(sampleRate);  // Store atomic sample rate
-    updateFilterCoefficients(*freqParam, *qParam);
-    updateEnvelopeIncrements(*pAttParam, *pDecParam, *aAttParam, *aDecParam, *duckAttParam, *duckDecParam, *colorAttParam, *colorDecParam, *detReleaseParam);
+
+    // Allocate the COLOR oversampler and the latency delays before parameters set their lengths
+    maxBlockSize = juce::jmax(1, samplesPerBlock);
+    const int delayFadeSamples = juce::roundToInt(delayFadeSeconds * sampleRate);
+    colorOversampler.prepare(maxBlockSize, delayFadeSamples);
+    wetDelay.prepare(4, colorOversampler.getMaxLatencySamples(), maxBlockSize, delayFadeSamples);
+    const int maxDryDelay = (int) std::ceil(maxLookaheadMs * 0.001 * sampleRate) + colorOversampler.getMaxLatencySamples();
+    dryDelay.prepare(2, maxDryDelay, maxBlockSize, delayFadeSamples);
+    dryDelayDouble.prepare(2, maxDryDelay, maxBlockSize, delayFadeSamples);
+    updateDetectorKey();
+    detectorBank.prepare((int) std::ceil(maxDetectorWindowMs * 0.001 * sampleRate));
+    inputKWeighting.prepare(sampleRate);
+    outputKWeighting.prepare(sampleRate);
+    agmIntegratorCoeff = 1.0 - std::exp(-1.0 / (agmIntegrationSeconds * sampleRate));
+    outputLimiter.prepare(sampleRate, maxBlockSize);
+    outputLimiter.setCeiling(outputCeiling);
+    spectrumAnalyser.setSampleRate(sampleRate);
+    bypassDelay.prepare(2, maxDryDelay + outputLimiter.getLatencySamples(), maxBlockSize, delayFadeSamples);
+    bypassDelayDouble.prepare(2, maxDryDelay + outputLimiter.getLatencySamples(), maxBlockSize, delayFadeSamples);
+
+    // Snapshot parameters and derive all coefficients for the new sample rate,
+    // then start the smoothers settled on their targets (no ramp on first block)
+    updateBlockParameters(true);
+
+    // Not on the audio thread here: report the latency now rather than asynchronously
+    cancelPendingUpdate();
+    setLatencySamples(pendingLatency.load());
+    for (auto* smoothed : { &detScaleSmoothed, &wetGainSmoothed, &duckDepthSmoothed, &mixSmoothed, &dryMixSmoothed })
+    {
+        smoothed->reset(sampleRate, 0.02);
+        smoothed->setCurrentAndTargetValue(smoothed->getTargetValue());
+    }
+
+    bypassFade.reset(sampleRate, bypassFadeSeconds);
+    bypassFade.setCurrentAndTargetValue(bypassFade.getTargetValue());
+
+    updateDryHPTable();
+
+    // Allocate block-stage scratch (aligned + padded for SIMDRegister access)
+    scratch = juce::dsp::AudioBlock<float>(scratchMemory, (size_t) numScratchChannels, (size_t) maxBlockSize);
+    for (size_t ch = 0; ch < scratch.getNumChannels(); ++ch)
+        juce::FloatVectorOperations::clear(scratch.getChannelPointer(ch), getNumSIMDSamples(maxBlockSize));
+
+    // Host-precision scratch for both processing precisions (the host may switch between prepares)
+    hostScratch = juce::dsp::AudioBlock<float>(hostScratchMemory, (size_t) numHostScratchChannels, (size_t) maxBlockSize);
+    hostScratchDouble = juce::dsp::AudioBlock<double>(hostScratchDoubleMemory, (size_t) numHostScratchChannels, (size_t) maxBlockSize);
+    hostScratch.clear();
+    hostScratchDouble.clear();
 
     // Reset all internal state
     resetInternalState();
@@ -124,41 +210,43 @@ void NewProjectAudioProcessor::resetInternalState()
 {
     // Reset trigger and synthesis state
     isTriggered = false;
-    currentPhase = 0.0f;
-    detectorEnv = 0.0f;
+    triggerHeld = false;
+    detectorBank.reset();
+    idle = false;
+    quietSamples = 0;
+
+    dryDelay.reset();
+    dryDelayDouble.reset();
+    wetDelay.reset();
+    colorOversampler.reset();
+    bypassDelay.reset();
+    bypassDelayDouble.reset();
+    bypassEngaged = false;
 
     // Reset Envelope States
-    envAmplitude = 0.0f;
-    envPitchValue = 0.0f;
-    envDucking = 0.0f;
-    envColor = 0.0f;
-    pitchState = 0;
-    ampState = 0;
-    duckState = 0;
-    colorState = 0;
-
-    // Reset Peak Detection
-    peakSampleCounter = 0;
-    currentMin = 0.0f;
-    currentMax = 0.0f;
-
-    // Reset Envelope Aggregation
-    envSampleCounter = 0;
-    peakDetector = 0.0f;
-    peakSynthesizer = 0.0f;
-    peakOutput = 0.0f;
+    voices.reset();
+    duckEnv.reset();
 
     // Reset filter state
-    f_x1 = 0.0f; f_x2 = 0.0f; f_y1 = 0.0f; f_y2 = 0.0f;
-    dry_hp_x1[0] = 0.0f; dry_hp_y1[0] = 0.0f;
-    dry_hp_x1[1] = 0.0f; dry_hp_y1[1] = 0.0f;
+    dry_hp_x1[0] = 0.0; dry_hp_y1[0] = 0.0;
+    dry_hp_x1[1] = 0.0; dry_hp_y1[1] = 0.0;
+
+    // Restart the noise stream
+    reseedNoise();
 
     // Reset MIDI state
     midiNoteOn = false;
     currentMidiNote = -1;
     currentMidiVelocity = 0.0f;
 
-    // Reset AGM gain (preserves sample rate)
+    // Reset AGM loudness integration and gain (preserves sample rate)
+    inputKWeighting.reset();
+    outputKWeighting.reset();
+    agmInputPower = 0.0;
+    agmOutputPower = 0.0;
+    agmHopPosition = 0;
+    outputLimiter.reset();
+
     if (currentSampleRate > 0)
     {
         agmGain.reset(currentSampleRate, 0.05);
@@ -166,31 +254,17 @@ void NewProjectAudioProcessor::resetInternalState()
     }
 }
 
-void NewProjectAudioProcessor::clearScopeBuffers()
+void NewProjectAudioProcessor::reseedNoise()
 {
-    // Clear legacy scope buffer
-    scopeBuffer.clear();
-    scopeWritePos = 0;
-
-    // Clear dual scope buffers (detector and output)
-    detectorScopeBuffer.clear();
-    outputScopeBuffer.clear();
-    dualScopeWritePos = 0;
-
-    // Clear peak buffer
-    for (auto& peak : peakBuffer) {
-        peak.minValue = 0.0f;
-        peak.maxValue = 0.0f;
-    }
-    peakWritePos = 0;
-
-    // Clear envelope buffer
-    for (auto& point : envelopeBuffer) {
-        point.detector = 0.0f;
-        point.synthesizer = 0.0f;
-        point.output = 0.0f;
-    }
-    envelopeFifo.reset();
+    // Offline bounces (or an explicit seed) are reproducible bit-for-bit
+    const auto fixedSeed = fixedNoiseSeed.load();
+
+    if (fixedSeed >= 0)
+        noise.seed((juce::uint32) fixedSeed);
+    else if (isNonRealtime())
+        noise.seed(NoiseGenerator::defaultSeed);
+    else
+        noise.seed(instanceNoiseSeed);
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -199,454 +273,792 @@ bool NewProjectAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
     if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
      && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
         return false;
-    return true;
+
+    // Main input matches the output (the dry path is processed in place)
+    if (layouts.getMainInputChannelSet() != layouts.getMainOutputChannelSet())
+        return false;
+
+    // Optional sidechain key: off, mono or stereo
+    const auto sidechain = layouts.getChannelSet(true, 1);
+    return sidechain.isDisabled()
+        || sidechain == juce::AudioChannelSet::mono()
+        || sidechain == juce::AudioChannelSet::stereo();
 }
 #endif
 
-void NewProjectAudioProcessor::pushNextSampleIntoFifo (float sample)
+void NewProjectAudioProcessor::updateDetectorKey()
 {
-    if (fifoIndex == fftSize) {
-        if (!nextFFTBlockReady) {
-            std::fill(fftData.begin(), fftData.end(), 0.0f);
-            std::copy(fifo.begin(), fifo.end(), fftData.begin());
-            nextFFTBlockReady = true;
-        }
-        fifoIndex = 0;
+    const auto* sidechain = getBus(true, 1);
+
+    if (sidechain != nullptr && sidechain->isEnabled() && sidechain->getNumberOfChannels() > 0)
+    {
+        keyChannel = getChannelIndexInProcessBlockBuffer(true, 1, 0);
+        numKeyChannels = juce::jmin(2, sidechain->getNumberOfChannels());
+    }
+    else
+    {
+        keyChannel = 0;
+        numKeyChannels = juce::jlimit(1, 2, getMainBusNumInputChannels());
     }
-    fifo[fifoIndex++] = sample;
 }
 
 void NewProjectAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processBlockInternal(buffer, midiMessages);
+}
+
+void NewProjectAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processBlockInternal(buffer, midiMessages);
+}
+
+bool NewProjectAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template <typename SampleType>
+void NewProjectAudioProcessor::processBlockInternal (juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumInputChannels  = getMainBusNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
     auto numSamples = buffer.getNumSamples();
 
-    float currentInputRMS = buffer.getRMSLevel(0, 0, numSamples);
-    inputRMS = currentInputRMS;
-
     // Check for shuffle/reset request (thread-safe)
     if (shouldShuffle.exchange(false))  // Atomically read and reset flag
     {
         resetInternalState();
-        clearScopeBuffers();
     }
 
     // Sync MIDI messages to keyboardState (for virtual keyboard visualization)
     keyboardState.processNextMidiBuffer(midiMessages, 0, numSamples, true);
 
-    // Process MIDI messages
-    bool midiMode = midiModeParam->load() > 0.5f;
-    bool midiPitchControl = midiPitchParam->load() > 0.5f;
+    // Read parameters once for the whole block
+    updateBlockParameters(false);
+    
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, numSamples);
 
-    // MIDI edge detection flag (trigger only once per buffer on note-on transition)
-    bool midiTriggerThisBuffer = false;
+    jassert (maxBlockSize > 0);  // prepareToPlay must run before processBlock
+    if (maxBlockSize <= 0)
+        return;
 
-    for (const auto metadata : midiMessages)
+    // Idle: nothing to detect, nothing sounding -> no synthesis, capture or FFT feed
+    if (updateIdleState(buffer, midiMessages))
     {
-        auto message = metadata.getMessage();
-
-        if (message.isNoteOn())
+        // Any note-on wakes the processor, but note-offs still have to update the note state
+        for (const auto metadata : midiMessages)
         {
-            currentMidiNote = message.getNoteNumber();
-            currentMidiVelocity = message.getVelocity() / 127.0f;
+            const auto message = metadata.getMessage();
+            if (message.isNoteOnOrOff())
+                handleNoteMessage(message);
+        }
 
-            // Detect note-on edge (transition from off to on)
-            if (!midiNoteOn)
-            {
-                midiTriggerThisBuffer = true;  // Mark that we should trigger this buffer
-            }
+        for (int ch = 0; ch < totalNumOutputChannels; ++ch)
+            buffer.clear(ch, 0, numSamples);
+        return;
+    }
 
-            midiNoteOn = true;
-        }
-        else if (message.isNoteOff())
+    // Render in place up to each note event, so note-ons/offs land on their exact sample
+    // (chunks are also capped at the scratch size, hosts may deliver more than samplesPerBlock)
+    int startSample = 0;
+    bool midiTriggerPending = false;
+
+    auto renderUpTo = [&] (int endSample)
+    {
+        while (startSample < endSample)
         {
-            if (message.getNoteNumber() == currentMidiNote)
-            {
-                midiNoteOn = false;
-                currentMidiNote = -1;
-            }
+            const int blockSize = juce::jmin(maxBlockSize, endSample - startSample);
+            renderSubBlock(buffer, startSample, blockSize, midiTriggerPending);
+            midiTriggerPending = false;
+            startSample += blockSize;
         }
+    };
+
+    for (const auto metadata : midiMessages)
+    {
+        const auto message = metadata.getMessage();
+        if (!message.isNoteOnOrOff())
+            continue;
+
+        renderUpTo(juce::jlimit(startSample, numSamples, metadata.samplePosition));
+
+        // Every note-on retriggers at its own sample position
+        if (handleNoteMessage(message))
+            midiTriggerPending = true;
     }
 
-    updateFilterCoefficients(*freqParam, *qParam);
-    updateEnvelopeIncrements(*pAttParam, *pDecParam, *aAttParam, *aDecParam, *duckAttParam, *duckDecParam, *colorAttParam, *colorDecParam, *detReleaseParam);
-    
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, numSamples);
+    renderUpTo(numSamples);
+
+    // Meters: K-weighted RMS from the AGM integrators (no extra sweeps over the buffer)
+    inputRMS = (float) std::sqrt(agmInputPower);
+    outputRMS = (float) std::sqrt(agmOutputPower);
+}
+
+template <typename SampleType>
+bool NewProjectAudioProcessor::updateIdleState (const juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages)
+{
+    const int numSamples = buffer.getNumSamples();
+
+    bool wake = isTriggered || (!blockParams.midiMode && detectorBank.isAboveThreshold());
+
+    for (int ch = 0; ch < getTotalNumInputChannels() && !wake; ++ch)
+        wake = buffer.getMagnitude(ch, 0, numSamples) >= (SampleType) silenceFloor;
+
+    for (const auto metadata : midiMessages)
+    {
+        if (wake)
+            break;
+        wake = metadata.getMessage().isNoteOn();
+    }
+
+    if (wake)
+    {
+        idle = false;
+        quietSamples = 0;
+        return false;
+    }
+
+    // Stay awake until the delay lines and filters have rung out
+    const int holdSamples = dryDelay.getDelay() + outputLimiter.getLatencySamples() + juce::roundToInt(idleSettleSeconds * currentSampleRate);
+    if (quietSamples < holdSamples)
+    {
+        quietSamples = juce::jmin(holdSamples, quietSamples + numSamples);
+        return false;
+    }
+
+    if (!idle)
+        enterIdle();
+
+    // Smoothers jump to their targets (no stale ramp on wake-up)
+    for (auto* smoothed : { &detScaleSmoothed, &wetGainSmoothed, &duckDepthSmoothed, &mixSmoothed, &dryMixSmoothed, &bypassFade })
+        smoothed->setCurrentAndTargetValue(smoothed->getTargetValue());
+
+    return true;
+}
+
+void NewProjectAudioProcessor::enterIdle()
+{
+    idle = true;
+
+    // Everything left in the state is below the floor: flush it once
+    dryDelay.reset();
+    dryDelayDouble.reset();
+    bypassDelay.reset();
+    bypassDelayDouble.reset();
+    wetDelay.reset();
+    colorOversampler.reset();
+    detectorBank.reset();
+    dry_hp_x1[0] = 0.0; dry_hp_y1[0] = 0.0;
+    dry_hp_x1[1] = 0.0; dry_hp_y1[1] = 0.0;
+
+    // Silent input -> AGM would settle at unity
+    inputKWeighting.reset();
+    outputKWeighting.reset();
+    agmInputPower = 0.0;
+    agmOutputPower = 0.0;
+    agmGain.setCurrentAndTargetValue(1.0f);
+    outputLimiter.reset();
+    inputRMS = 0.0f;
+    outputRMS = 0.0f;
+    isTriggeredUI = false;
+}
+
+template <typename SampleType>
+void NewProjectAudioProcessor::processOutputStage (juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples)
+{
+    const auto* inputPower = scratch.getChannelPointer(scratchAgmInputPower);
+    auto* outputPower = scratch.getChannelPointer(scratchAgmOutputPower);
+    auto* agmRamp = scratch.getChannelPointer(scratchAgmRamp);
+    const int numChannels = juce::jmin(getTotalNumOutputChannels(), buffer.getNumChannels());
+
+    // K-weighted power of the mix before gain
+    outputKWeighting.process(buffer.getReadPointer(0, startSample),
+                             numChannels > 1 ? buffer.getReadPointer(1, startSample) : nullptr,
+                             outputPower, numSamples);
+
+    // Integrate per sample; the AGM ramp is written hop by hop and the target moves at hop ends
+    for (int pos = 0; pos < numSamples;)
+    {
+        const int run = juce::jmin(numSamples - pos, agmHopSamples - agmHopPosition);
 
-    bool isAuditioning = auditionParam->load() > 0.5f;
-    auto* scopeWrite = scopeBuffer.getWritePointer(0);
-    int scopeSize = scopeBuffer.getNumSamples();
-
-    for (int sample = 0; sample < numSamples; ++sample)
-    {
-        float inputL = buffer.getReadPointer(0)[sample];
-        float inputMono = inputL;
-        if (totalNumInputChannels > 1)
-            inputMono = (inputL + buffer.getReadPointer(1)[sample]) * 0.5f;
-
-        // 1. Detector Filter
-        float tf_out = bf0 * inputMono + bf1 * f_x1 + bf2 * f_x2 - af1 * f_y1 - af2 * f_y2;
-        f_x2 = f_x1; f_x1 = inputMono;
-        f_y2 = f_y1; f_y1 = tf_out;
-
-        // Apply Detector Scale (50-400%) to increase/decrease detector sensitivity
-        float detScale = detScaleParam->load() / 100.0f;  // Convert % to linear gain
-        float scaledInput = std::abs(tf_out) * detScale;
-
-        if (scaledInput > detectorEnv) detectorEnv = scaledInput;
-        else detectorEnv = detectorEnv * detectorReleaseCoeff + scaledInput * (1.0f - detectorReleaseCoeff);
-
-        // Legacy Scope Buffer (keep for compatibility)
-        scopeWrite[scopeWritePos] = tf_out;
-        scopeWritePos = (scopeWritePos + 1) % scopeSize;
-
-        // Peak Detection for Professional Scope Display
-        if (peakSampleCounter == 0) {
-            // Initialize new peak window
-            currentMin = tf_out;
-            currentMax = tf_out;
-        } else {
-            // Update min/max
-            if (tf_out < currentMin) currentMin = tf_out;
-            if (tf_out > currentMax) currentMax = tf_out;
+        for (int i = pos; i < pos + run; ++i)
+        {
+            agmInputPower += agmIntegratorCoeff * (inputPower[i] - agmInputPower);
+            agmOutputPower += agmIntegratorCoeff * (outputPower[i] - agmOutputPower);
         }
 
-        peakSampleCounter++;
-        if (peakSampleCounter >= peakDetectionWindowSize) {
-            // Store the min/max pair
-            int writeIndex = peakWritePos.load();
-            peakBuffer[writeIndex].minValue = currentMin;
-            peakBuffer[writeIndex].maxValue = currentMax;
-            peakWritePos = (writeIndex + 1) % peakBufferSize;
-
-            // Reset for next window
-            peakSampleCounter = 0;
-            currentMin = 0.0f;
-            currentMax = 0.0f;
+        if (agmGain.isSmoothing())
+        {
+            for (int i = pos; i < pos + run; ++i)
+                agmRamp[i] = agmGain.getNextValue();
+        }
+        else
+        {
+            juce::FloatVectorOperations::fill(agmRamp + pos, agmGain.getTargetValue(), run);
         }
 
-        // 2. Retriggerable Trigger (Audio or MIDI)
-        // Release time controls detector decay, naturally preventing false retriggers
-        bool shouldTrigger = false;
+        agmHopPosition += run;
+        if (agmHopPosition == agmHopSamples)
+        {
+            agmHopPosition = 0;
+            updateAgmTarget();
+        }
+
+        pos += run;
+    }
 
-        if (midiMode)
+    // AGM gain, then the lookahead limiter brings peaks to the -0.01dB ceiling
+    SampleType* channels[OutputLimiter::maxChannels] {};
+    const int numLimiterChannels = juce::jmin(numChannels, (int) OutputLimiter::maxChannels);
+
+    for (int ch = 0; ch < numLimiterChannels; ++ch)
+    {
+        channels[ch] = buffer.getWritePointer(ch, startSample);
+
+        if constexpr (std::is_same_v<SampleType, float>)
         {
-            // MIDI Mode: trigger ONLY on first sample if we received a note-on edge this buffer
-            // This prevents retriggering every sample while holding a key
-            if (midiTriggerThisBuffer && sample == 0)
-            {
-                shouldTrigger = true;
-            }
+            juce::FloatVectorOperations::multiply(channels[ch], agmRamp, numSamples);
         }
         else
         {
-            // Audio Mode: trigger on detector envelope
-            float threshLin = juce::Decibels::decibelsToGain(threshParam->load());
-            float ceilingLin = juce::Decibels::decibelsToGain(ceilingParam->load());
-            bool inRange = (detectorEnv > threshLin) && (detectorEnv < ceilingLin || ceilingLin >= 0.99f);
+            for (int i = 0; i < numSamples; ++i)
+                channels[ch][i] *= (SampleType) agmRamp[i];
+        }
+    }
 
-            if (inRange && detectorEnv > threshLin)
-            {
-                shouldTrigger = true;
-            }
+    outputLimiter.process(channels, numLimiterChannels, numSamples);
+}
+
+void NewProjectAudioProcessor::updateAgmTarget()
+{
+    // Loudness match with a +6dB max constraint; unity while either side is below the gate
+    float target = 1.0f;
+
+    if (blockParams.agm && agmInputPower > agmGatePower && agmOutputPower > agmGatePower)
+    {
+        const float maxGain = juce::Decibels::decibelsToGain(6.0f);
+        target = juce::jlimit(0.1f, maxGain, (float) std::sqrt(agmInputPower / agmOutputPower));
+    }
+
+    agmGain.setTargetValue(target);
+}
+
+bool NewProjectAudioProcessor::handleNoteMessage (const juce::MidiMessage& message)
+{
+    if (message.isNoteOn())
+    {
+        currentMidiNote = message.getNoteNumber();
+        currentMidiVelocity = message.getVelocity() / 127.0f;
+        midiNoteOn = true;
+        return true;
+    }
+
+    if (message.isNoteOff() && message.getNoteNumber() == currentMidiNote)
+    {
+        midiNoteOn = false;
+        currentMidiNote = -1;
+    }
+
+    return false;
+}
+
+template <typename SampleType>
+void NewProjectAudioProcessor::renderSubBlock (juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples, bool midiTrigger)
+{
+    // Settled bypass: detector and bypass delay only
+    if (!bypassFade.isSmoothing() && bypassFade.getTargetValue() >= 1.0f)
+    {
+        if (!bypassEngaged)
+            engageBypass();
+
+        renderBypassed(buffer, startSample, numSamples);
+        return;
+    }
+
+    bypassEngaged = false;
+    const bool bypassFading = bypassFade.isSmoothing();
+
+    // Per-sample parameter ramps for this sub-block
+    fillSmoothedRamps(numSamples);
+
+    // 1. Detector filter + envelope follower
+    processDetectorStage(buffer, startSample, numSamples);
+
+    // The bypass line follows the input either way; it is read back only while fading
+    feedBypassDelay(buffer, startSample, numSamples, bypassFading);
+
+    // 2-4. Trigger, voices (envelopes, oscillator, COLOR) + ducking envelope
+    triggerStreamStart = scopeRing.getNumPushed();
+    triggerStreamCaptured = blockParams.scopeTap && !blockParams.audition && !blockParams.bypass;
+    (this->*voiceStageKernel)(numSamples, midiTrigger);
+
+    // 4. Noise layer + wet gain -> wet signal
+    processWetStage(numSamples);
+
+    // 5-6. Ducking, mix and output
+    (this->*getSelectedMixStageKernel<SampleType>())(buffer, startSample, numSamples);
+
+    // 7. AGM, limiting and makeup
+    processOutputStage(buffer, startSample, numSamples);
+
+    // 8. Bypass crossfade: processed output <-> latency-aligned input
+    if (bypassFading)
+    {
+        auto* fade = scratch.getChannelPointer(scratchBypassFadeRamp);
+        fillRamp(bypassFade, fade, numSamples);
+
+        const int numChannels = juce::jmin(getTotalNumOutputChannels(), buffer.getNumChannels(), 2);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* output = buffer.getWritePointer(ch, startSample);
+            const auto* bypassed = getHostScratch<SampleType>((HostScratchChannel) (hostScratchBypassLeft + ch));
+
+            for (int i = 0; i < numSamples; ++i)
+                output[i] += (bypassed[i] - output[i]) * (SampleType) fade[i];
         }
+    }
+
+    // === Two-way Scope Capture (V19.3 - Detector vs Output), only while subscribed ===
+    if (triggerStreamCaptured)
+        captureOutputScope(buffer.getReadPointer(0, startSample), numSamples);
+}
+
+template <typename SampleType>
+void NewProjectAudioProcessor::renderBypassed (juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples)
+{
+    // Detector only: band filters, law windows and envelopes keep following the key, so
+    // the first transient after un-bypass triggers as if bypass had never been engaged
+    auto* detScale = scratch.getChannelPointer(scratchDetScaleRamp);
+    fillRamp(detScaleSmoothed, detScale, numSamples);
+
+    const auto* keyLeft = buffer.getReadPointer(keyChannel, startSample);
+    const auto* keyRight = numKeyChannels > 1 ? buffer.getReadPointer(keyChannel + 1, startSample) : keyLeft;
+    detectorBank.process(keyLeft, keyRight, detScale,
+                         scratch.getChannelPointer(scratchDetector),
+                         scratch.getChannelPointer(scratchDetectorEnv),
+                         scratch.getChannelPointer(scratchTriggerGate), numSamples);
+
+    // The input leaves at the reported latency, delayed in place (no synthesis, scopes or FFT)
+    auto& delay = getBypassDelay<SampleType>();
+    const int numChannels = juce::jmin(getTotalNumOutputChannels(), buffer.getNumChannels(), 2);
+    for (int ch = 0; ch < numChannels; ++ch)
+        delay.process(ch, buffer.getWritePointer(ch, startSample), numSamples);
+    delay.advance(numSamples);
+}
+
+template <typename SampleType>
+void NewProjectAudioProcessor::feedBypassDelay (juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples, bool readBack)
+{
+    auto& delay = getBypassDelay<SampleType>();
+    const int numChannels = juce::jmin(getTotalNumOutputChannels(), buffer.getNumChannels(), 2);
 
-        if (shouldTrigger)
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* input = buffer.getReadPointer(ch, startSample);
+
+        if (readBack)
+        {
+            auto* bypassed = getHostScratch<SampleType>((HostScratchChannel) (hostScratchBypassLeft + ch));
+            juce::FloatVectorOperations::copy(bypassed, input, numSamples);
+            delay.process(ch, bypassed, numSamples);
+        }
+        else
         {
-            // Retriggerable behavior: check mode (Hard vs Soft)
-            bool hardMode = retriggerModeHard.load();
+            delay.write(ch, input, numSamples);
+        }
+    }
+    delay.advance(numSamples);
+}
+
+void NewProjectAudioProcessor::engageBypass()
+{
+    bypassEngaged = true;
+
+    // Nothing reads the synthesis path while bypassed: flush it once, so un-bypass fades
+    // in from silence instead of replaying stale delay lines and voices
+    voices.reset();
+    duckEnv.reset();
+    isTriggered = false;
+    triggerHeld = false;
+    isTriggeredUI = false;
+
+    dryDelay.reset();
+    dryDelayDouble.reset();
+    wetDelay.reset();
+    colorOversampler.reset();
+    dry_hp_x1[0] = 0.0; dry_hp_y1[0] = 0.0;
+    dry_hp_x1[1] = 0.0; dry_hp_y1[1] = 0.0;
+    inputKWeighting.reset();
+    outputKWeighting.reset();
+    outputLimiter.reset();
+}
+
+template <typename SampleType>
+void NewProjectAudioProcessor::processDetectorStage (const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples)
+{
+    auto* detector = scratch.getChannelPointer(scratchDetector);
+    auto* detEnv = scratch.getChannelPointer(scratchDetectorEnv);
+    auto* triggerGate = scratch.getChannelPointer(scratchTriggerGate);
+    const auto* detScale = scratch.getChannelPointer(scratchDetScaleRamp);
+
+    // AGM input loudness (main input, before the mix stage overwrites it)
+    inputKWeighting.process(buffer.getReadPointer(0, startSample),
+                            getMainBusNumInputChannels() > 1 ? buffer.getReadPointer(1, startSample) : nullptr,
+                            scratch.getChannelPointer(scratchAgmInputPower), numSamples);
+
+    // Key channels straight from the host buffer; a mono key reads the same channel twice
+    // ((x + x) * 0.5 == x, so the sum stays branch-free)
+    const auto* keyLeft = buffer.getReadPointer(keyChannel, startSample);
+    const auto* keyRight = numKeyChannels > 1 ? buffer.getReadPointer(keyChannel + 1, startSample) : keyLeft;
+
+    // All bands in parallel lanes (biquads in the host precision): band-pass, rectify x
+    // Detector Scale (50-400%), instant attack / one-pole release, per-band threshold
+    detectorBank.process(keyLeft, keyRight, detScale, detector, detEnv, triggerGate, numSamples);
+}
+
+void NewProjectAudioProcessor::pushTriggerEvent (int sample, float level, TriggerEvent::Source source) noexcept
+{
+    if (!blockParams.triggerTap)
+        return;
+
+    TriggerEvent event;
+    event.position = triggerStreamStart + (triggerStreamCaptured ? sample : 0);
+    event.level = level;
+    event.source = source;
+
+    triggerEvents.push(event);  // Dropped if the UI is not draining
+}
+
+template <bool MidiMode>
+void NewProjectAudioProcessor::processVoiceStage (int numSamples, bool midiTrigger)
+{
+    const auto* triggerGate = scratch.getChannelPointer(scratchTriggerGate);
+    const auto* detEnv = scratch.getChannelPointer(scratchDetectorEnv);
+    auto* voiceOut = scratch.getChannelPointer(scratchOscillator);
+    auto* ampOut = scratch.getChannelPointer(scratchEnvAmp);
+    auto* duckOut = scratch.getChannelPointer(scratchEnvDuck);
+    auto* dryFilterGate = scratch.getChannelPointer(scratchDryFilterGate);
+
+    const bool midiPitchControl = blockParams.midiPitch;
+    const float startFreq = blockParams.startFreq;
+    const float peakFreq  = blockParams.peakFreq;
+
+    // Phase increment in fixed-point units (2^32 = one cycle per sample)
+    const float incrementPerHz = 4294967296.0f / (float)currentSampleRate;
+
+    VoicePool::RenderSettings settings;
+    settings.bank = wavetables.get();
+    settings.shape = juce::jlimit(0, (int) WavetableBank::numShapes - 1, juce::roundToInt(blockParams.shape));
+    settings.startIncrement = startFreq * incrementPerHz;
+    settings.rangeIncrement = (peakFreq - startFreq) * incrementPerHz;
+    settings.colorAmount = blockParams.colorAmount / 100.0f;  // 0.0 - 1.0
+    settings.colorOversampling = colorOversampler.getFactor();
+    float* colorOut = colorOversampler.getHighRateBuffer();
+    const int oversampling = settings.colorOversampling;
+
+    // MIDI Pitch Mode: Fixed pitch per key (no envelope modulation)
+    // MIDI note 69 = A4 = 440Hz, like 808/909 drum machine
+    const bool midiPitch = MidiMode && midiPitchControl && currentMidiNote >= 0;
+    const float midiFreq = midiPitch ? 440.0f * std::pow(2.0f, (currentMidiNote - 69) / 12.0f) : 0.0f;
+
+    // Hard Retrigger resets the envelopes it restarts; Soft keeps 30% for a smooth transition
+    const float retriggerKeep = blockParams.hardRetrigger ? 0.0f : 0.3f;
+
+    // 2. Retriggerable Trigger (Audio or MIDI)
+    // Release time controls detector decay, naturally preventing false retriggers
+    auto shouldTriggerAt = [&] (int sample)
+    {
+        // MIDI Mode: trigger ONLY on the first sample of a sub-block that starts at a note-on
+        if constexpr (MidiMode)
+            return midiTrigger && sample == 0;
+
+        // Audio Mode: any routed detector band between its threshold and the ceiling
+        return triggerGate[sample] > 0.5f;
+    };
 
-            if (hardMode)
+    int pos = 0;
+    while (pos < numSamples)
+    {
+        // Retrigger point (scalar): a new hit starts a voice, a held trigger restarts the newest
+        if (shouldTriggerAt(pos))
+        {
+            if (MidiMode || !triggerHeld)
             {
-                // Hard Retrigger: Immediately reset all envelopes
-                envAmplitude = 0.0f;
-                envPitchValue = 0.0f;
-                envDucking = 0.0f;
-                envColor = 0.0f;
+                voices.startVoice(retriggerKeep, midiFreq * incrementPerHz);
+                pushTriggerEvent(pos, MidiMode ? currentMidiVelocity : detEnv[pos],
+                                 MidiMode ? TriggerEvent::Source::midi : TriggerEvent::Source::audio);
             }
             else
-            {
-                // Soft Retrigger: Keep 30% of previous envelope for smooth transition
-                envAmplitude *= 0.3f;
-                envPitchValue *= 0.3f;
-                envDucking *= 0.3f;
-                envColor *= 0.3f;
-            }
+                voices.retriggerNewest(retriggerKeep);
 
-            // Restart envelope generators
+            duckEnv.retrigger(retriggerKeep);
             isTriggered = true;
-            pitchState = 0;
-            ampState = 0;
-            duckState = 0;
-            colorState = 0;
-            currentPhase = 1.5707f;
+            triggerHeld = true;
         }
-        isTriggeredUI = isTriggered;
-
-        // 3. Envelopes
-        if (isTriggered)
+        else
         {
-            if (pitchState == 0) { envPitchValue += pitchAttackInc; if(envPitchValue>=1.0f) {envPitchValue=1.0f; pitchState=1;} }
-            else { envPitchValue -= pitchDecayInc; if(envPitchValue<=0.0f) envPitchValue=0.0f; }
-            
-            if (ampState == 0) { envAmplitude += ampAttackInc; if(envAmplitude>=1.0f) {envAmplitude=1.0f; ampState=1;} }
-            else { envAmplitude -= ampDecayInc; if(envAmplitude<=0.0f) {envAmplitude=0.0f; isTriggered=false;} }
-
-            if (duckState == 0) { envDucking += duckAttackInc; if(envDucking>=1.0f) {envDucking=1.0f; duckState=1;} }
-            else { envDucking -= duckDecayInc; if(envDucking<=0.0f) envDucking=0.0f; }
-
-            // COLOR envelope (dynamic harmonic content)
-            if (colorState == 0) { envColor += colorAttackInc; if(envColor>=1.0f) {envColor=1.0f; colorState=1;} }
-            else { envColor -= colorDecayInc; if(envColor<=0.0f) envColor=0.0f; }
+            triggerHeld = false;
         }
-        
-        // 4. Synthesis (Dual-Oscillator with Dynamic COLOR)
-        float startFreq = startFreqParam->load();
-        float peakFreq  = peakFreqParam->load();
-        float oscShape  = shapeParam->load();
-        float colorAmount = colorAmountParam->load() / 100.0f;  // 0.0 - 1.0
-        float noiseAmount = noiseParam->load() / 100.0f;
-
-        // Calculate frequency (MIDI or parameter-based)
-        float currentFreq;
-        if (midiMode && midiPitchControl && currentMidiNote >= 0)
+
+        // The run extends to the next retrigger point
+        int next = pos + 1;
+        while (next < numSamples && !shouldTriggerAt(next))
+            ++next;
+
+        if (next > pos + 1)
+            triggerHeld = false;
+
+        const int runLength = next - pos;
+        int triggeredLength = 0;  // Samples that end with isTriggered still true
+
+        // 3-4. Voices + ducking (ducking freezes once the last voice finishes)
+        if (isTriggered)
         {
-            // MIDI Pitch Mode: Fixed pitch per key (no envelope modulation)
-            // MIDI note 69 = A4 = 440Hz
-            // Each key triggers a fixed frequency, like 808/909 drum machine
-            currentFreq = 440.0f * std::pow(2.0f, (currentMidiNote - 69) / 12.0f);
+            const int activeLength = voices.render(settings, voiceOut + pos, colorOut + pos * oversampling, ampOut + pos, runLength);
+
+            duckEnv.render(duckOut + pos, activeLength);
+            duckEnv.hold(duckOut + pos + activeLength, runLength - activeLength);
 
-            // Update UI display variables (only once per buffer)
-            if (sample == 0)
+            if (!voices.isActive())
             {
-                lastMidiNoteUI.store(currentMidiNote);
-                lastFrequencyUI.store(currentFreq);
+                isTriggered = false;
+                triggeredLength = activeLength - 1;
             }
-        }
-        else if (midiMode && !midiPitchControl)
-        {
-            // MIDI Trigger Mode: All keys trigger same sound (use START/PEAK with envelope)
-            currentFreq = startFreq + (peakFreq - startFreq) * envPitchValue;
-
-            // Update UI display
-            if (sample == 0)
+            else
             {
-                lastMidiNoteUI.store(currentMidiNote);
-                lastFrequencyUI.store(currentFreq);
+                triggeredLength = runLength;
             }
         }
         else
         {
-            // Audio Mode: use START_FREQ and PEAK_FREQ with envelope (sweep effect)
-            currentFreq = startFreq + (peakFreq - startFreq) * envPitchValue;
-
-            // Clear MIDI display in audio mode
-            if (sample == 0)
-            {
-                lastMidiNoteUI.store(-1);
-                lastFrequencyUI.store(0.0f);
-            }
+            juce::FloatVectorOperations::clear(voiceOut + pos, runLength);
+            juce::FloatVectorOperations::clear(colorOut + pos * oversampling, runLength * oversampling);
+            juce::FloatVectorOperations::clear(ampOut + pos, runLength);
+            duckEnv.hold(duckOut + pos, runLength);
         }
 
-        currentPhase += (currentFreq / (float)currentSampleRate) * juce::MathConstants<float>::twoPi;
-        if (currentPhase > juce::MathConstants<float>::twoPi) currentPhase -= juce::MathConstants<float>::twoPi;
+        // High-pass the dry path only while triggered (prevents low-freq buildup during ducking)
+        for (int i = 0; i < runLength; ++i)
+            dryFilterGate[pos + i] = (i < triggeredLength && duckOut[pos + i] > 0.01f) ? 1.0f : 0.0f;
 
-        // Generate clean oscillator (base layer)
-        float cleanOsc = 0.0f;
-        if (oscShape < 0.5f)
-            cleanOsc = std::sin(currentPhase);
-        else if (oscShape < 1.5f)
-            cleanOsc = 1.0f - 2.0f * std::abs((currentPhase / juce::MathConstants<float>::pi) - 1.0f);
-        else
-            cleanOsc = (currentPhase < juce::MathConstants<float>::pi) ? 1.0f : -1.0f;
+        pos = next;
+    }
 
-        // Generate dirty oscillator (harmonic-rich layer)
-        float dirtyOsc = cleanOsc;
+    isTriggeredUI = isTriggered;
 
-        // Add harmonics through waveshaping (soft clipping + asymmetric distortion)
-        float drive = 1.0f + 4.0f * colorAmount;  // Drive scales with COLOR amount
-        dirtyOsc = dirtyOsc * drive;
-        dirtyOsc = dirtyOsc / (1.0f + std::abs(dirtyOsc));  // Soft clip
+    // MIDI Trigger Mode shows the note; Audio Mode clears the MIDI display
+    if (midiPitch)
+    {
+        lastMidiNoteUI.store(currentMidiNote);
+        lastFrequencyUI.store(midiFreq);
+    }
+    else
+    {
+        const bool showMidi = MidiMode && !midiPitchControl;
+        lastMidiNoteUI.store(showMidi ? currentMidiNote : -1);
+        lastFrequencyUI.store(showMidi ? startFreq + (peakFreq - startFreq) * voices.getNewestPitch() : 0.0f);
+    }
+}
 
-        // Add asymmetric harmonics (even harmonics)
-        dirtyOsc = dirtyOsc + 0.15f * colorAmount * dirtyOsc * dirtyOsc;
+void NewProjectAudioProcessor::processWetStage (int numSamples)
+{
+    auto* voiceSum = scratch.getChannelPointer(scratchOscillator);
+    auto* colorLayer = scratch.getChannelPointer(scratchColorLayer);
+    auto* envAmp = scratch.getChannelPointer(scratchEnvAmp);
+    auto* envDuck = scratch.getChannelPointer(scratchEnvDuck);
+    auto* dryFilterGate = scratch.getChannelPointer(scratchDryFilterGate);
+    auto* wet = scratch.getChannelPointer(scratchWet);
+    const auto* wetGain = scratch.getChannelPointer(scratchWetGainRamp);
+    const int numSIMDSamples = getNumSIMDSamples(numSamples);
+    const float noiseAmount = blockParams.noise / 100.0f;
+
+    // COLOR layer back to the base rate; the clean layer, amp sum and the ducking
+    // envelope (with its dry high-pass gate) wait for the decimator
+    colorOversampler.downsample(colorLayer, numSamples);
+
+    // A COLOR_OS switch completed (with the layer silent): move the delays to the new latency
+    if (colorOversampler.getLatencySamples() != wetDelay.getDelay())
+        updateLatency();
+
+    wetDelay.process(0, voiceSum, numSamples);
+    wetDelay.process(1, envAmp, numSamples);
+    wetDelay.process(2, envDuck, numSamples);
+    wetDelay.process(3, dryFilterGate, numSamples);
+    wetDelay.advance(numSamples);
+
+    juce::FloatVectorOperations::add(voiceSum, colorLayer, numSamples);
+
+    // Noise layer (block-generated into the wet channel, which is written last),
+    // shaped by the summed amplitude envelopes like the oscillator it sits on
+    if (noiseAmount > 0.0f)
+    {
+        noise.fill(wet, numSamples);
+        for (int i = 0; i < numSIMDSamples; i += simdWidth)
+        {
+            auto layered = SIMDFloat::fromRawArray(voiceSum + i)
+                         + SIMDFloat::fromRawArray(wet + i) * SIMDFloat::fromRawArray(envAmp + i) * noiseAmount;
+            (layered * SIMDFloat::fromRawArray(wetGain + i)).copyToRawArray(wet + i);
+        }
+        return;
+    }
 
-        // Mix clean and dirty based on COLOR envelope
-        float colorMix = colorAmount * envColor;  // Dynamic modulation
-        float oscMixed = cleanOsc * (1.0f - colorMix) + dirtyOsc * colorMix;
+    // Wet gain (stateless, SIMD)
+    for (int i = 0; i < numSIMDSamples; i += simdWidth)
+        (SIMDFloat::fromRawArray(voiceSum + i) * SIMDFloat::fromRawArray(wetGain + i)).copyToRawArray(wet + i);
+}
 
-        // Add noise layer
-        float noiseRaw = (juce::Random::getSystemRandom().nextFloat() * 2.0f - 1.0f) * noiseAmount;
-        float oscFinal = oscMixed + noiseRaw;
+template <typename SampleType, NewProjectAudioProcessor::OutputMode Mode>
+void NewProjectAudioProcessor::processMixStage (juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples)
+{
+    const auto* detector = scratch.getChannelPointer(scratchDetector);
+    const auto* envDuck = scratch.getChannelPointer(scratchEnvDuck);
+    const auto* dryFilterGate = scratch.getChannelPointer(scratchDryFilterGate);
+    const auto* wet = scratch.getChannelPointer(scratchWet);
+    auto* dryGain = scratch.getChannelPointer(scratchDryGain);
+    auto* dry = getHostScratch<SampleType>(hostScratchDry);
+    const auto* duckDepth = scratch.getChannelPointer(scratchDuckDepthRamp);
+    const auto* mixPct = scratch.getChannelPointer(scratchMixRamp);
+    const auto* dryMixPct = scratch.getChannelPointer(scratchDryMixRamp);
+    const int numSIMDSamples = getNumSIMDSamples(numSamples);
+    const int numChannels = juce::jmin(getTotalNumOutputChannels(), buffer.getNumChannels());
+
+    // Lookahead: delay the dry path in place (the detector already saw the undelayed input)
+    auto& delay = getDryDelay<SampleType>();
+    for (int ch = 0; ch < numChannels; ++ch)
+        delay.process(ch, buffer.getWritePointer(ch, startSample), numSamples);
+    delay.advance(numSamples);
+
+    // FFT tap: wet + original input on channel 0 (before it is overwritten), handed to
+    // the analyser as one block and only while a spectrum display is subscribed
+    if (blockParams.spectrumTap)
+    {
+        auto* tap = scratch.getChannelPointer(scratchSpectrumTap);
+        const auto* input = buffer.getReadPointer(0, startSample);
+        for (int i = 0; i < numSamples; ++i)
+            tap[i] = wet[i] + (float) input[i];
 
-        float finalWet = oscFinal * envAmplitude * juce::Decibels::decibelsToGain(wetParam->load());
+        spectrumAnalyser.push(tap, numSamples);
+    }
 
-        // 5. Spectral Ducking (only when triggered)
-        float duckDB = duckParam->load();
-        float duckAmount = 1.0f - juce::Decibels::decibelsToGain(duckDB);
-        float currentDuckGain = 1.0f - (envDucking * duckAmount);
+    if constexpr (Mode == OutputMode::audition)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            copyToHost(buffer.getWritePointer(ch, startSample), detector, numSamples);
+        return;
+    }
 
-        float mixPct = mixParam->load() / 100.0f;
-        float dryMixPct = dryParam->load() / 100.0f;
-        bool useSoftClip = clipParam->load() > 0.5f;
-        bool isBypassed = bypassParam->load() > 0.5f;
+    // 5. Spectral Ducking gain with the dry mix folded in (stateless, SIMD)
+    const auto one = SIMDFloat::expand(1.0f);
+    for (int i = 0; i < numSIMDSamples; i += simdWidth)
+    {
+        auto duckGain = one - SIMDFloat::fromRawArray(envDuck + i) * SIMDFloat::fromRawArray(duckDepth + i);
+        (duckGain * SIMDFloat::fromRawArray(dryMixPct + i)).copyToRawArray(dryGain + i);
+    }
 
-        // 6. Output
-        for (int ch = 0; ch < totalNumOutputChannels; ++ch)
+    // Dry high-pass pole from the ducking envelope (table lookup, once for all channels)
+    auto* dryHPCoeff = scratch.getChannelPointer(scratchDryHPCoeff);
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (dryFilterGate[i] > 0.5f)
         {
-             auto* channelData = buffer.getWritePointer (ch);
-             float drySig = channelData[sample];
-
-             if (ch == 0) pushNextSampleIntoFifo(finalWet + drySig); // FFT
-
-             if (isAuditioning)
-             {
-                 channelData[sample] = tf_out;
-             }
-             else if (isBypassed)
-             {
-                 // Bypass: pass through original signal unchanged
-                 channelData[sample] = drySig;
-             }
-             else
-             {
-                 float processedDry = drySig;
-
-                 // Apply high-pass filter only when triggered (to prevent low-freq buildup during ducking)
-                 if (isTriggered && envDucking > 0.01f)
-                 {
-                     float dryHPFreq = 20.0f + (envDucking * 300.0f);
-                     float hp_w0 = 2.0f * juce::MathConstants<float>::pi * dryHPFreq / (float)currentSampleRate;
-                     float hp_x = std::exp(-hp_w0);
-                     float hp_a1 = hp_x;
-                     float hp_b0 = 0.5f * (1.0f + hp_x);
-                     float hp_b1 = -hp_b0;
-
-                     processedDry = hp_b0 * drySig + hp_b1 * dry_hp_x1[ch] + hp_a1 * dry_hp_y1[ch];
-                     dry_hp_x1[ch] = drySig;
-                     dry_hp_y1[ch] = processedDry;
-                 }
-
-                 // Apply ducking gain and dry mix
-                 float finalDry = processedDry * currentDuckGain * dryMixPct;
-
-                 // Additive Mix: DuckedDry + Wet * Mix
-                 float mixed = finalDry + (finalWet * mixPct);
-
-                 // Hard limiting at -0.01dB instead of soft clipping
-                 const float hardLimitThreshold = juce::Decibels::decibelsToGain(-0.01f);
-                 if (useSoftClip) {
-                     if (mixed > hardLimitThreshold) mixed = hardLimitThreshold;
-                     else if (mixed < -hardLimitThreshold) mixed = -hardLimitThreshold;
-                 }
-
-                 channelData[sample] = mixed;
-
-                 // === Two-way Scope Capture (V19.3 - Detector vs Output) ===
-                 // Capture independent detector input and final output for comparison
-                 if (ch == 0)
-                 {
-                     int dualPos = dualScopeWritePos.load();
-
-                     detectorScopeBuffer.getWritePointer(0)[dualPos] = tf_out;
-                     outputScopeBuffer.getWritePointer(0)[dualPos] = mixed;
-
-                     dualScopeWritePos = (dualPos + 1) % dualScopeBufferSize;
-                 }
-
-                 // === Envelope Peak Aggregation (for EnvelopeView) ===
-                 // Only process once per sample (ch == 0)
-                 if (ch == 0)
-                 {
-                     // Accumulate peak values (linear amplitude)
-                     float currentDetector = std::abs(detectorEnv);
-                     float currentSynth = std::abs(envAmplitude);
-                     float currentOutput = std::abs(mixed);
-
-                     if (currentDetector > peakDetector) peakDetector = currentDetector;
-                     if (currentSynth > peakSynthesizer) peakSynthesizer = currentSynth;
-                     if (currentOutput > peakOutput) peakOutput = currentOutput;
-
-                     envSampleCounter++;
-
-                     // Every 128 samples, push aggregated peak to FIFO (unless frozen)
-                     if (envSampleCounter >= envUpdateRate)
-                     {
-                         if (!isFrozen.load())
-                         {
-                             EnvelopeDataPoint dataPoint;
-                             dataPoint.detector = peakDetector;
-                             dataPoint.synthesizer = peakSynthesizer;
-                             dataPoint.output = peakOutput;
-
-                             // Write to FIFO (lock-free)
-                             int start1, size1, start2, size2;
-                             envelopeFifo.prepareToWrite(1, start1, size1, start2, size2);
-
-                             if (size1 > 0)
-                                 envelopeBuffer[start1] = dataPoint;
-
-                             envelopeFifo.finishedWrite(size1);
-                         }
-                         else
-                         {
-                             // When frozen, clear FIFO to prevent accumulation
-                             envelopeFifo.reset();
-                         }
-
-                         // Reset for next window
-                         envSampleCounter = 0;
-                         peakDetector = 0.0f;
-                         peakSynthesizer = 0.0f;
-                         peakOutput = 0.0f;
-                     }
-                 }
-             }
+            const float index = juce::jlimit(0.0f, 1.0f, envDuck[i]) * (float) dryHPTableSize;
+            const int i0 = juce::jmin((int) index, dryHPTableSize - 1);
+            const float frac = index - (float) i0;
+            dryHPCoeff[i] = dryHPCoeffTable[(size_t) i0] + frac * (dryHPCoeffTable[(size_t) i0 + 1] - dryHPCoeffTable[(size_t) i0]);
         }
     }
-    
-    // AGM with +6dB max constraint and -60dB safety threshold
-    float currentOutputRMS = buffer.getRMSLevel(0, 0, numSamples);
-    outputRMS = currentOutputRMS;
-    if (agmParam->load() > 0.5f) {
-        float target = 1.0f;
-        const float minThreshold = juce::Decibels::decibelsToGain(-60.0f);
-        const float maxGain = juce::Decibels::decibelsToGain(6.0f);
-
-        if (currentOutputRMS > minThreshold && currentInputRMS > minThreshold) {
-            float computedGain = currentInputRMS / currentOutputRMS;
-            target = juce::jlimit(0.1f, maxGain, computedGain);
-        }
-        agmGain.setTargetValue(target);
-    } else { agmGain.setTargetValue(1.0f); }
-    agmGain.applyGain(buffer, buffer.getNumSamples());
-
-    // Soft Clipper: -0.01dB limiting with +0.01dB makeup gain
-    const float limitThreshold = juce::Decibels::decibelsToGain(-0.01f);
-    const float makeupGain = juce::Decibels::decibelsToGain(0.01f);
 
-    for (int ch = 0; ch < totalNumOutputChannels; ++ch)
+    // 6. Output
+    jassert (numChannels <= 2);  // dry_hp state is stereo
+    for (int ch = 0; ch < numChannels; ++ch)
     {
-        auto* channelData = buffer.getWritePointer(ch);
-        for (int sample = 0; sample < numSamples; ++sample)
+        auto* channelData = buffer.getWritePointer(ch, startSample);
+
+        // Apply high-pass filter only when triggered (stateful, scalar)
+        auto hpX1 = (SampleType) dry_hp_x1[ch];
+        auto hpY1 = (SampleType) dry_hp_y1[ch];
+        for (int i = 0; i < numSamples; ++i)
         {
-            float value = channelData[sample];
+            const SampleType drySig = channelData[i];
+            SampleType processedDry = drySig;
 
-            // Apply limiting
-            if (value > limitThreshold)
-                value = limitThreshold;
-            else if (value < -limitThreshold)
-                value = -limitThreshold;
+            if (dryFilterGate[i] > 0.5f)
+            {
+                SampleType hp_x = dryHPCoeff[i];
+                SampleType hp_a1 = hp_x;
+                SampleType hp_b0 = (SampleType) 0.5 * ((SampleType) 1 + hp_x);
+                SampleType hp_b1 = -hp_b0;
+
+                processedDry = hp_b0 * drySig + hp_b1 * hpX1 + hp_a1 * hpY1;
+                hpX1 = drySig;
+                hpY1 = processedDry;
+            }
+
+            dry[i] = processedDry;
+        }
+        dry_hp_x1[ch] = hpX1;
+        dry_hp_y1[ch] = hpY1;
 
-            // Apply makeup gain
-            channelData[sample] = value * makeupGain;
+        // Additive Mix: DuckedDry + Wet * Mix (stateless; SIMD in float, widened per sample in double)
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            for (int i = 0; i < numSIMDSamples; i += simdWidth)
+            {
+                (SIMDFloat::fromRawArray(dry + i) * SIMDFloat::fromRawArray(dryGain + i)
+                  + SIMDFloat::fromRawArray(wet + i) * SIMDFloat::fromRawArray(mixPct + i)).copyToRawArray(dry + i);
+            }
         }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dry[i] = dry[i] * (SampleType) dryGain[i] + (SampleType) wet[i] * (SampleType) mixPct[i];
+        }
+
+        juce::FloatVectorOperations::copy(channelData, dry, numSamples);
     }
 }
 
+template <typename SampleType>
+NewProjectAudioProcessor::MixStageKernel<SampleType> NewProjectAudioProcessor::getMixStageKernel (OutputMode mode) noexcept
+{
+    using Processor = NewProjectAudioProcessor;
+
+    // [output mode]
+    static constexpr MixStageKernel<SampleType> mixKernels[] =
+    {
+        &Processor::processMixStage<SampleType, OutputMode::normal>,
+        &Processor::processMixStage<SampleType, OutputMode::audition>
+    };
+
+    return mixKernels[(int) mode];
+}
+
+void NewProjectAudioProcessor::selectRenderKernels()
+{
+    static constexpr VoiceStageKernel voiceKernels[] =
+    {
+        &NewProjectAudioProcessor::processVoiceStage<false>,  // Audio trigger
+        &NewProjectAudioProcessor::processVoiceStage<true>    // MIDI trigger
+    };
+
+    const auto outputMode = blockParams.audition ? OutputMode::audition : OutputMode::normal;
+
+    voiceStageKernel = voiceKernels[blockParams.midiMode ? 1 : 0];
+    mixStageKernel = getMixStageKernel<float>(outputMode);
+    mixStageKernelDouble = getMixStageKernel<double>(outputMode);
+}
+
+template <typename SampleType>
+void NewProjectAudioProcessor::captureOutputScope (const SampleType* output, int numSamples)
+{
+    const auto* detector = scratch.getChannelPointer(scratchDetector);
+
+    // Capture independent detector input and final output for comparison
+    scopeRing.push(detector, output, numSamples);
+}
+
 bool NewProjectAudioProcessor::hasEditor() const { return true; }
 juce::AudioProcessorEditor* NewProjectAudioProcessor::createEditor() { return new NewProjectAudioProcessorEditor (*this); }
 void NewProjectAudioProcessor::getStateInformation (juce::MemoryBlock& destData) {}
@@ -660,10 +1072,25 @@ juce::AudioProcessorValueTreeState::ParameterLayout NewProjectAudioProcessor::cr
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("CEILING", 1), "Ceiling", juce::NormalisableRange<float>(-60.0f, 0.0f, 0.1f), 0.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("DET_REL", 1), "Rel", juce::NormalisableRange<float>(1.0f, 500.0f, 1.0f), 20.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("DET_SCALE", 1), "Scale", juce::NormalisableRange<float>(50.0f, 400.0f, 1.0f), 100.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
+    layout.add (std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("DET_MODE", 1), "Det Mode", juce::StringArray("Peak", "RMS", "Hold", "Hybrid"), 0));
+    layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("DET_WIN", 1), "Det Win", juce::NormalisableRange<float>(1.0f, 50.0f, 0.1f), 10.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
+    layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("LOOKAHEAD", 1), "Lookahead", juce::NormalisableRange<float>(0.0f, 10.0f, 0.1f), 0.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("F_FREQ", 1), "F.Freq", juce::NormalisableRange<float>(20.0f, 10000.0f, 1.0f, 0.3f), 120.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("F_Q", 1), "F.Q", juce::NormalisableRange<float>(0.1f, 10.0f, 0.01f), 1.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("AUDITION", 1), "Audition", juce::StringArray("Off", "On"), 0));
 
+    // Detector bands (band 1 is THRESHOLD / F_FREQ / F_Q above; bands 2-4 start unrouted)
+    layout.add (std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("B1_TRIG", 1), "B1 Trig", juce::StringArray("Off", "On"), 1));
+    const float bandDefaultFreqs[] = { 250.0f, 150.0f, 2000.0f };  // Snare body, toms, cymbals
+    for (int b = 2; b <= DetectorBank::maxBands; ++b)
+    {
+        const juce::String prefix = "B" + juce::String(b);
+        layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(prefix + "_THRESH", 1), prefix + " Thresh", juce::NormalisableRange<float>(-60.0f, 0.0f, 0.1f), -30.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
+        layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(prefix + "_FREQ", 1), prefix + " Freq", juce::NormalisableRange<float>(20.0f, 10000.0f, 1.0f, 0.3f), bandDefaultFreqs[b - 2], "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
+        layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(prefix + "_Q", 1), prefix + " Q", juce::NormalisableRange<float>(0.1f, 10.0f, 0.01f), 1.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
+        layout.add (std::make_unique<juce::AudioParameterChoice>(juce::ParameterID(prefix + "_TRIG", 1), prefix + " Trig", juce::StringArray("Off", "On"), 0));
+    }
+
     // Generator
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("START_FREQ", 1), "Start", juce::NormalisableRange<float>(20.0f, 1000.0f, 1.0f, 0.4f), 50.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("PEAK_FREQ", 1), "Peak", juce::NormalisableRange<float>(20.0f, 1000.0f, 1.0f, 0.4f), 80.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
@@ -671,6 +1098,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout NewProjectAudioProcessor::cr
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("COLOR_AMOUNT", 1), "Color", juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f), 40.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("COLOR_ATT", 1), "C.Att", juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f), 5.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("COLOR_DEC", 1), "C.Dec", juce::NormalisableRange<float>(0.0f, 500.0f, 1.0f), 150.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
+    layout.add (std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("COLOR_OS", 1), "C.OS", juce::StringArray("1x", "2x", "4x", "8x"), 0));
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("NOISE_MIX", 1), "Noise", juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f), 0.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
 
     // Envelope
@@ -678,6 +1106,8 @@ juce::AudioProcessorValueTreeState::ParameterLayout NewProjectAudioProcessor::cr
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("P_DEC", 1), "P.Dec", juce::NormalisableRange<float>(0.0f, 2000.0f, 1.0f), 150.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("A_ATT", 1), "A.Att", juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f), 2.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("A_DEC", 1), "A.Dec", juce::NormalisableRange<float>(0.0f, 2000.0f, 1.0f), 100.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
+    layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("ENV_CURVE", 1), "Curve", juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f), 0.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
+    layout.add (std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("VOICES", 1), "Voices", juce::StringArray("1", "2", "4", "8"), 3));
 
     // Output
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("DUCKING", 1), "Duck dB", juce::NormalisableRange<float>(-48.0f, 0.0f, 0.1f), -12.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
@@ -687,7 +1117,10 @@ juce::AudioProcessorValueTreeState::ParameterLayout NewProjectAudioProcessor::cr
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("DRY_MIX", 1), "Dry %", juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f), 100.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("MIX", 1), "Mix %", juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f), 50.0f, "", juce::AudioProcessorParameter::genericParameter, nullptr, nullptr));
     layout.add (std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("AGM_MODE", 1), "AGM", juce::StringArray("Off", "On"), 0));
-    layout.add (std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("SOFT_CLIP", 1), "Clip", juce::StringArray("Off", "On"), 1));
+    // SOFT_CLIP is kept only so old sessions and automation still resolve: the output
+    // limiter replaced both clips and it no longer has any effect
+    layout.add (std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("SOFT_CLIP", 1), "Clip (Legacy)", juce::StringArray("Off", "On"), 1));
+    layout.add (std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("TRUE_PEAK", 1), "True Peak", juce::StringArray("Off", "On"), 0));
     layout.add (std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("BYPASS", 1), "Bypass", juce::StringArray("Off", "On"), 0));
 
     // MIDI
@@ -997,27 +1430,181 @@ void NewProjectAudioProcessor::copyBtoA()
     snapshotA = snapshotB;
 }
 
-void NewProjectAudioProcessor::updateFilterCoefficients(float freq, float Q) {
-    if (currentSampleRate <= 0) return;
-    float w0 = 2.0f * juce::MathConstants<float>::pi * freq / (float)currentSampleRate;
-    float alpha = std::sin(w0) / (2.0f * Q);
-    float b0 = alpha; float b1 = 0.0f; float b2 = -alpha;
-    float a0 = 1.0f + alpha; float a1 = -2.0f * std::cos(w0); float a2 = 1.0f - alpha;
-    bf0 = b0/a0; bf1 = b1/a0; bf2 = b2/a0; af1 = a1/a0; af2 = a2/a0;
+void NewProjectAudioProcessor::updateBlockParameters(bool forceUpdate)
+{
+    const auto previous = blockParams;
+    auto& p = blockParams;
+
+    p.ceiling     = ceilingParam->load();
+    p.detRelease  = detReleaseParam->load();
+    p.detScale    = detScaleParam->load();
+    p.detLaw      = juce::jlimit(0, 3, (int) detModeParam->load());
+    p.detWindow   = detWindowParam->load();
+    p.startFreq   = startFreqParam->load();
+    p.peakFreq    = peakFreqParam->load();
+    p.shape       = shapeParam->load();
+    p.noise       = noiseParam->load();
+    p.colorAmount = colorAmountParam->load();
+    p.colorAtt    = colorAttParam->load();
+    p.colorDec    = colorDecParam->load();
+    p.pAtt        = pAttParam->load();
+    p.pDec        = pDecParam->load();
+    p.aAtt        = aAttParam->load();
+    p.aDec        = aDecParam->load();
+    p.envCurve    = envCurveParam->load();
+    p.duck        = duckParam->load();
+    p.duckAtt     = duckAttParam->load();
+    p.duckDec     = duckDecParam->load();
+    p.wet         = wetParam->load();
+    p.dry         = dryParam->load();
+    p.mix         = mixParam->load();
+    p.lookahead   = lookaheadParam->load();
+    p.numVoices   = 1 << juce::jlimit(0, 3, (int) voicesParam->load());
+    p.colorOversampling = juce::jlimit(0, ColorOversampler::maxFactorIndex, (int) colorOversamplingParam->load());
+    p.audition    = auditionParam->load() > 0.5f;
+    p.agm         = agmParam->load() > 0.5f;
+    p.truePeak    = truePeakParam->load() > 0.5f;
+    p.bypass      = bypassParam->load() > 0.5f;
+    p.midiMode    = midiModeParam->load() > 0.5f;
+    p.midiPitch   = midiPitchParam->load() > 0.5f;
+    p.hardRetrigger = retriggerModeHard.load();
+
+    p.scopeTap    = telemetryTaps.isActive(TelemetryTaps::scope);
+    p.triggerTap  = telemetryTaps.isActive(TelemetryTaps::triggerEvents);
+    p.spectrumTap = telemetryTaps.isActive(TelemetryTaps::spectrum);
+
+    for (size_t b = 0; b < (size_t) DetectorBank::maxBands; ++b)
+    {
+        p.bandThreshold[b] = bandThreshParams[b]->load();
+        p.bandFreq[b]      = bandFreqParams[b]->load();
+        p.bandQ[b]         = bandQParams[b]->load();
+        p.bandTrigger[b]   = bandTriggerParams[b]->load() > 0.5f;
+    }
+
+    // Dirty flags: only derive what actually changed
+    const bool envelopeDirty = forceUpdate
+        || p.pAtt != previous.pAtt || p.pDec != previous.pDec
+        || p.aAtt != previous.aAtt || p.aDec != previous.aDec
+        || p.duckAtt != previous.duckAtt || p.duckDec != previous.duckDec
+        || p.colorAtt != previous.colorAtt || p.colorDec != previous.colorDec
+        || p.detRelease != previous.detRelease || p.envCurve != previous.envCurve;
+
+    for (int b = 0; b < DetectorBank::maxBands; ++b)
+    {
+        const auto i = (size_t) b;
+        if (forceUpdate || p.bandFreq[i] != previous.bandFreq[i] || p.bandQ[i] != previous.bandQ[i])
+            detectorBank.setBand(b, currentSampleRate, p.bandFreq[i], p.bandQ[i]);
+
+        if (forceUpdate || p.bandThreshold[i] != previous.bandThreshold[i] || p.bandTrigger[i] != previous.bandTrigger[i])
+            detectorBank.setThreshold(b, juce::Decibels::decibelsToGain(p.bandThreshold[i]), p.bandTrigger[i]);
+    }
+
+    if (envelopeDirty)
+        updateEnvelopeSegments(p.pAtt, p.pDec, p.aAtt, p.aDec, p.duckAtt, p.duckDec, p.colorAtt, p.colorDec, p.detRelease, p.envCurve / 100.0f);
+
+    if (forceUpdate || p.ceiling != previous.ceiling)
+        detectorBank.setCeiling(juce::Decibels::decibelsToGain(p.ceiling));
+
+    if (forceUpdate || p.detLaw != previous.detLaw)
+        detectorBank.setLaw((DetectorBank::Law) p.detLaw);
+
+    if (forceUpdate || p.detWindow != previous.detWindow)
+        detectorBank.setWindowSamples(juce::roundToInt(p.detWindow * 0.001 * currentSampleRate));
+
+    // Gain-like parameters ramp to their new targets (no zipper noise under automation)
+    if (forceUpdate || p.detScale != previous.detScale)
+        detScaleSmoothed.setTargetValue(p.detScale / 100.0f);  // Convert % to linear gain
+
+    if (forceUpdate || p.wet != previous.wet)
+        wetGainSmoothed.setTargetValue(juce::Decibels::decibelsToGain(p.wet));
+
+    if (forceUpdate || p.duck != previous.duck)
+        duckDepthSmoothed.setTargetValue(1.0f - juce::Decibels::decibelsToGain(p.duck));
+
+    if (forceUpdate || p.mix != previous.mix)
+        mixSmoothed.setTargetValue(p.mix / 100.0f);
+
+    if (forceUpdate || p.dry != previous.dry)
+        dryMixSmoothed.setTargetValue(p.dry / 100.0f);
+
+    if (forceUpdate || p.bypass != previous.bypass)
+        bypassFade.setTargetValue(p.bypass ? 1.0f : 0.0f);
+
+    if (forceUpdate || p.truePeak != previous.truePeak)
+        outputLimiter.setTruePeak(p.truePeak);
+
+    if (forceUpdate || p.numVoices != previous.numVoices)
+        voices.setNumVoices(p.numVoices);
+
+    // While playing, the COLOR layer fades out, switches and fades back in
+    if (forceUpdate)
+        colorOversampler.setFactorIndex(p.colorOversampling);
+    else if (p.colorOversampling != previous.colorOversampling)
+        colorOversampler.requestFactorIndex(p.colorOversampling);
+
+    // Mode flags -> specialised stage instantiations for this block
+    selectRenderKernels();
+
+    // (A COLOR_OS latency change is picked up when the switch completes, in processWetStage)
+    if (forceUpdate || p.lookahead != previous.lookahead)
+        updateLatency();
+}
+
+void NewProjectAudioProcessor::updateLatency()
+{
+    // The wet path is late by the COLOR decimator; the dry path additionally by the
+    // lookahead. Host delay compensation shifts everything back by the dry delay, so
+    // the detected transient and the generated sub line up with the source
+    const int colorLatency = colorOversampler.getLatencySamples();
+    wetDelay.setDelay(colorLatency);
+    dryDelay.setDelay(juce::roundToInt(blockParams.lookahead * 0.001 * currentSampleRate) + colorLatency);
+    dryDelayDouble.setDelay(dryDelay.getDelay());
+
+    // The output limiter delays both paths by its lookahead
+    const int totalLatency = dryDelay.getDelay() + outputLimiter.getLatencySamples();
+    bypassDelay.setDelay(totalLatency);
+    bypassDelayDouble.setDelay(totalLatency);
+    if (pendingLatency.exchange(totalLatency) != totalLatency)
+        triggerAsyncUpdate();
+}
+
+void NewProjectAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(pendingLatency.load());
+}
+
+void NewProjectAudioProcessor::fillSmoothedRamps(int numSamples)
+{
+    fillRamp(detScaleSmoothed, scratch.getChannelPointer(scratchDetScaleRamp), numSamples);
+    fillRamp(wetGainSmoothed, scratch.getChannelPointer(scratchWetGainRamp), numSamples);
+    fillRamp(duckDepthSmoothed, scratch.getChannelPointer(scratchDuckDepthRamp), numSamples);
+    fillRamp(mixSmoothed, scratch.getChannelPointer(scratchMixRamp), numSamples);
+    fillRamp(dryMixSmoothed, scratch.getChannelPointer(scratchDryMixRamp), numSamples);
+}
+
+void NewProjectAudioProcessor::updateDryHPTable() {
+    if (currentSampleRate <= 0.0) return;  // Safety check
+
+    // Cutoff follows the ducking envelope: 20 Hz (no ducking) to 320 Hz (full ducking)
+    for (int i = 0; i <= dryHPTableSize; ++i)
+    {
+        float dryHPFreq = 20.0f + ((float) i / (float) dryHPTableSize) * 300.0f;
+        float hp_w0 = 2.0f * juce::MathConstants<float>::pi * dryHPFreq / (float)currentSampleRate;
+        dryHPCoeffTable[(size_t) i] = std::exp(-hp_w0);
+    }
 }
 
-void NewProjectAudioProcessor::updateEnvelopeIncrements(float pAtt, float pDec, float aAtt, float aDec, float dAtt, float dDec, float cAtt, float cDec, float detRel) {
+void NewProjectAudioProcessor::updateEnvelopeSegments(float pAtt, float pDec, float aAtt, float aDec, float dAtt, float dDec, float cAtt, float cDec, float detRel, float curve) {
     if (currentSampleRate <= 0.0) return;  // Safety check
     float sr_ms = (float)currentSampleRate / 1000.0f;
-    pitchAttackInc = 1.0f / (pAtt * sr_ms + 1.0f);
-    pitchDecayInc = 1.0f / (pDec * sr_ms + 1.0f);
-    ampAttackInc = 1.0f / (aAtt * sr_ms + 1.0f);
-    ampDecayInc = 1.0f / (aDec * sr_ms + 1.0f);
-    duckAttackInc = 1.0f / (dAtt * sr_ms + 1.0f);
-    duckDecayInc = 1.0f / (dDec * sr_ms + 1.0f);
-    colorAttackInc = 1.0f / (cAtt * sr_ms + 1.0f);
-    colorDecayInc = 1.0f / (cDec * sr_ms + 1.0f);
-    detectorReleaseCoeff = 1.0f - std::exp(-1.0f / (detRel * sr_ms));
+
+    // Segment lengths in samples (+1 keeps 0 ms at a one-sample step); curve shapes the decays
+    voices.setEnvelopeSegments(pAtt * sr_ms + 1.0f, pDec * sr_ms + 1.0f,
+                               aAtt * sr_ms + 1.0f, aDec * sr_ms + 1.0f,
+                               cAtt * sr_ms + 1.0f, cDec * sr_ms + 1.0f, curve);
+    duckEnv.setAttack(dAtt * sr_ms + 1.0f);
+    duckEnv.setDecay(dDec * sr_ms + 1.0f, curve);
+    detectorBank.setReleaseCoefficient(1.0f - std::exp(-1.0f / (detRel * sr_ms)));
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter() { return new NewProjectAudioProcessor(); }
@@ -8,9 +8,22 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "EnvelopeView.h"  // For EnvelopeDataPoint
-
-class NewProjectAudioProcessor  : public juce::AudioProcessor
+#include "WavetableBank.h"
+#include "NoiseGenerator.h"
+#include "SegmentEnvelope.h"
+#include "VoicePool.h"
+#include "LookaheadDelay.h"
+#include "ColorOversampler.h"
+#include "DetectorBank.h"
+#include "KWeighting.h"
+#include "OutputLimiter.h"
+#include "ScopeCaptureRing.h"
+#include "TriggerEventQueue.h"
+#include "SpectrumAnalyser.h"
+#include "TelemetryTaps.h"
+
+class NewProjectAudioProcessor  : public juce::AudioProcessor,
+                                  private juce::AsyncUpdater
 {
 public:
     NewProjectAudioProcessor();
@@ -24,6 +37,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -52,8 +67,8 @@ public:
     // Reset internal state (clear envelopes, phase, AGM, etc.) without changing parameters
     void resetInternalState();
 
-    // Clear oscilloscope buffers (for shuffle/reset function)
-    void clearScopeBuffers();
+    // Fixed noise seed for realtime playback too (offline renders always use a fixed seed)
+    void setNoiseSeed(std::optional<juce::uint32> seed) { fixedNoiseSeed.store(seed ? (juce::int64) *seed : -1); }
 
     // Request shuffle/reset from UI thread (thread-safe)
     void requestShuffle() { shouldShuffle.store(true); }
@@ -69,32 +84,17 @@ public:
     std::atomic<float> lastFrequencyUI { 0.0f };
 
     // --- UI Shared Data (Public) ---
-    // V19.3 两路独立示波器缓冲 (Detector/Output)
-    juce::AudioBuffer<float> scopeBuffer;  // Legacy, kept for compatibility
-    std::atomic<int> scopeWritePos { 0 };
-
-    // Two independent buffers for oscilloscope visualization
-    static constexpr int dualScopeBufferSize = 48000;  // 1 second @ 48kHz
-    juce::AudioBuffer<float> detectorScopeBuffer;      // Detector filtered input
-    juce::AudioBuffer<float> outputScopeBuffer;        // Final mixed output
-    std::atomic<int> dualScopeWritePos { 0 };          // Shared write position
-
-    // Min/Max Peak Detection Buffer for Scope (V18)
-    struct PeakPair {
-        float minValue = 0.0f;
-        float maxValue = 0.0f;
-    };
-    static constexpr int peakBufferSize = 1024;
-    std::array<PeakPair, peakBufferSize> peakBuffer;
-    std::atomic<int> peakWritePos { 0 };
+    // Visualisers subscribe to the streams below while showing; unsubscribed ones are
+    // not captured at all
+    TelemetryTaps telemetryTaps;
+
+    // Detector filtered input + final mixed output, published block by block (SPSC)
+    ScopeCaptureRing scopeRing;
 
-    // Envelope Visualization Data (V18.6 - Extended Buffer)
-    static constexpr int envelopeBufferSize = 4096;
-    std::array<EnvelopeDataPoint, envelopeBufferSize> envelopeBuffer;
-    juce::AbstractFifo envelopeFifo { envelopeBufferSize };
+    // Every new hit, stamped with its sample index in the scope stream
+    TriggerEventQueue triggerEvents;
 
     std::atomic<bool> isTriggeredUI { false };
-    std::atomic<bool> isFrozen { false };  // Freeze functionality
     std::atomic<bool> isDynamicZoomActive { false };  // Dynamic zoom state
     std::atomic<float> inputRMS { 0.0f };
     std::atomic<float> outputRMS { 0.0f };
@@ -109,76 +109,251 @@ public:
     // MIDI Keyboard State (for virtual keyboard visualization)
     juce::MidiKeyboardState keyboardState;
     
-    // FFT Data
-    enum { fftOrder = 11, fftSize = 1 << fftOrder };
-    std::array<float, fftSize * 2> fftData;
-    std::atomic<bool> nextFFTBlockReady { false };
-    
-    juce::dsp::FFT forwardFFT;
-    juce::dsp::WindowingFunction<float> window;
-    std::array<float, fftSize> fifo;
-    int fifoIndex = 0;
-    void pushNextSampleIntoFifo (float sample);
+    // Spectrum of the FFT tap (analysed on the analyser's own thread)
+    SpectrumAnalyser spectrumAnalyser;
 
 private:
     double currentSampleRate = 0.0;
 
-    // Peak Detection State
-    static constexpr int peakDetectionWindowSize = 256;
-    int peakSampleCounter = 0;
-    float currentMin = 0.0f;
-    float currentMax = 0.0f;
-
-    // Envelope Peak Aggregation (V18.6 - Optimized Update Rate)
-    static constexpr int envUpdateRate = 128;  // Aggregate every 128 samples (balanced performance)
-    int envSampleCounter = 0;
-    float peakDetector = 0.0f;
-    float peakSynthesizer = 0.0f;
-    float peakOutput = 0.0f;
-
-    float f_x1 = 0.0f, f_x2 = 0.0f;
-    float f_y1 = 0.0f, f_y2 = 0.0f;
-    float bf0, bf1, bf2, af1, af2;
-
-    float dry_hp_x1[2] = {0.0f, 0.0f};
-    float dry_hp_y1[2] = {0.0f, 0.0f};
-
-    bool isTriggered = false;
-    float currentPhase = 0.0f;
-
-    float envAmplitude = 0.0f;
-    float envPitchValue = 0.0f;
-    float envDucking = 0.0f;
-    float envColor = 0.0f;  // COLOR envelope value (0.0 - 1.0)
+    // Trigger detectors (band 0 = F_FREQ / F_Q / THRESHOLD, bands 1-3 = B2-B4)
+    static constexpr float maxDetectorWindowMs = 50.0f;
+    DetectorBank detectorBank;
+
+    // Filter state is kept in double so either processing precision can resume it
+    double dry_hp_x1[2] = {0.0, 0.0};
+    double dry_hp_y1[2] = {0.0, 0.0};
+
+    // Dry high-pass pole (exp(-w0)) indexed by ducking level, rebuilt on sample-rate change
+    static constexpr int dryHPTableSize = 128;
+    std::array<float, dryHPTableSize + 1> dryHPCoeffTable {};
+    void updateDryHPTable();
+
+    // Lookahead: the dry path is delayed so the detector runs ahead of it. Delay changes
+    // crossfade over delayFadeSeconds; the new latency is reported to the host from the
+    // message thread (setLatencySamples is not real-time safe)
+    static constexpr float maxLookaheadMs = 10.0f;
+    static constexpr double delayFadeSeconds = 0.02;
+    LookaheadDelay<float> dryDelay;
+    LookaheadDelay<double> dryDelayDouble;  // Same delay for double-precision processing
+    std::atomic<int> pendingLatency { 0 };
+    void updateLatency();
+    void handleAsyncUpdate() override;
+
+    template <typename SampleType>
+    LookaheadDelay<SampleType>& getDryDelay() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>) return dryDelayDouble;
+        else return dryDelay;
+    }
+
+    // Bypass: the output crossfades (bypassFadeSeconds) between the processed signal and
+    // the input delayed by the full reported latency. Once the fade settles, bypassed
+    // sub-blocks run only the detector (kept warm for an instant, correct un-bypass)
+    // and the bypass delay; synthesis state is flushed once on the way in.
+    static constexpr double bypassFadeSeconds = 0.01;
+    juce::LinearSmoothedValue<float> bypassFade { 0.0f };  // 1 = bypassed
+    LookaheadDelay<float> bypassDelay;
+    LookaheadDelay<double> bypassDelayDouble;
+    bool bypassEngaged = false;
+    void engageBypass();
+
+    template <typename SampleType>
+    LookaheadDelay<SampleType>& getBypassDelay() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>) return bypassDelayDouble;
+        else return bypassDelay;
+    }
+
+    // Oversampled COLOR layer; the clean layer, amp sum, ducking envelope and dry
+    // high-pass gate wait for its decimator (one wetDelay lane each)
+    ColorOversampler colorOversampler;
+    LookaheadDelay<float> wetDelay;
+
+    bool isTriggered = false;    // Any voice sounding
+
+    // Scope stream index of the current sub-block's first sample; sub-blocks that are
+    // not captured (audition / bypass / scope tap off) stamp their hits at that index
+    juce::int64 triggerStreamStart = 0;
+    bool triggerStreamCaptured = false;
+    void pushTriggerEvent(int sample, float level, TriggerEvent::Source source) noexcept;
+
+    bool triggerHeld = false;    // Audio trigger condition on the previous sample (edge detection)
+
+    // Idle sleep: once the input has been below the floor (and no voice has sounded) for
+    // the dry delay plus a settle time, blocks are cleared instead of rendered
+    static constexpr float silenceFloor = 1.0e-5f;      // -100 dBFS
+    static constexpr double idleSettleSeconds = 0.05;   // Detector / dry HP ring-out
+    bool idle = false;
+    int quietSamples = 0;
+
+    template <typename SampleType>
+    bool updateIdleState(const juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages);
+    void enterIdle();
+
+    // Band-limited SHAPE tables, shared by all instances
+    juce::SharedResourcePointer<WavetableBank> wavetables;
+
+    // NOISE_MIX source (per instance, reseeded on prepare/reset)
+    NoiseGenerator noise;
+    juce::uint32 instanceNoiseSeed = 0;
+    std::atomic<juce::int64> fixedNoiseSeed { -1 };  // -1 = no fixed seed
+    void reseedNoise();
+
+    // Sub voices (pitch/amp/COLOR envelopes + phase per voice)
+    VoicePool voices;
+
+    // Dry ducking envelope (one for all voices, rendered per segment run)
+    SegmentEnvelope duckEnv;
     
-    // Detector Envelope
-    float detectorEnv = 0.0f;
-
     // MIDI State
     int currentMidiNote = -1;  // -1 = no note, 0-127 = MIDI note number
     float currentMidiVelocity = 0.0f;  // 0.0 - 1.0
     bool midiNoteOn = false;
 
-    int pitchState = 0;
-    int ampState = 0;
-    int duckState = 0;
-    int colorState = 0;  // COLOR envelope state (0=idle, 1=attack, 2=decay)
-
-    float pitchAttackInc = 0.0f; float pitchDecayInc = 0.0f;
-    float ampAttackInc = 0.0f;   float ampDecayInc = 0.0f;
-    float duckAttackInc = 0.0f;  float duckDecayInc = 0.0f;
-    float colorAttackInc = 0.0f; float colorDecayInc = 0.0f;  // COLOR envelope increments
-    float detectorReleaseCoeff = 0.0f;
-    
     juce::LinearSmoothedValue<float> agmGain { 1.0f };
 
+    // AGM: K-weighted loudness of the main input and of the mix, integrated per sample.
+    // The gain target moves on a fixed hop grid that runs across blocks, so the gain
+    // curve is the same for any host buffer size.
+    static constexpr double agmIntegrationSeconds = 0.4;   // BS.1770 momentary window
+    static constexpr double agmGatePower = 1.1724653e-7;   // -70 LKFS absolute gate
+    static constexpr int agmHopSamples = 32;
+    KWeighting inputKWeighting, outputKWeighting;
+    double agmInputPower = 0.0, agmOutputPower = 0.0;
+    double agmIntegratorCoeff = 0.0;
+    int agmHopPosition = 0;
+    void updateAgmTarget();
+
+    // Output ceiling (-0.01 dBTP), after the AGM
+    OutputLimiter outputLimiter;
+
+    // === Block-Staged Processing ===
+    // Each stage runs over a whole (sub-)block using contiguous, SIMD-aligned
+    // scratch channels allocated in prepareToPlay (never on the audio thread).
+    enum ScratchChannel
+    {
+        scratchDetector = 0,    // Detector band-pass output (tf_out)
+        scratchDetectorEnv,     // Detector envelope (band 0)
+        scratchTriggerGate,     // 1.0 where a routed detector band is triggering
+        scratchEnvAmp,          // Amplitude envelopes (sum over voices)
+        scratchEnvDuck,         // Ducking envelope
+        scratchDryFilterGate,   // 1.0 where the ducking dry high-pass is active
+        scratchDryHPCoeff,      // Dry high-pass pole for this sample (shared by all channels)
+        scratchOscillator,      // Clean voice layer (oscillator * amplitude), then full voice sum
+        scratchColorLayer,      // COLOR layer back at the base rate
+        scratchWet,             // Final wet signal
+        scratchDryGain,         // Ducking gain * dry mix
+        scratchDetScaleRamp,    // Smoothed DET_SCALE (linear)
+        scratchWetGainRamp,     // Smoothed WET_GAIN (linear)
+        scratchDuckDepthRamp,   // Smoothed ducking depth (1 - DUCKING gain)
+        scratchMixRamp,         // Smoothed MIX (0-1)
+        scratchDryMixRamp,      // Smoothed DRY_MIX (0-1)
+        scratchAgmRamp,         // Smoothed AGM gain (output stage)
+        scratchAgmInputPower,   // K-weighted main input power
+        scratchAgmOutputPower,  // K-weighted mix power (before AGM)
+        scratchBypassFadeRamp,  // Bypass crossfade (1 = bypassed), while fading
+        scratchSpectrumTap,     // Wet + input (channel 0) for the spectrum analyser
+        numScratchChannels
+    };
+
+    juce::HeapBlock<char> scratchMemory;
+    juce::dsp::AudioBlock<float> scratch;
+    int maxBlockSize = 0;
+
+    // Host scratch: carries host samples in the host's processing precision
+    enum HostScratchChannel
+    {
+        hostScratchDry = 0,         // Per-channel processed dry, then mixed output
+        hostScratchBypassLeft,      // Input delayed by the latency, while fading bypass
+        hostScratchBypassRight,
+        numHostScratchChannels
+    };
+
+    // Detector key: the sidechain bus when enabled, else the main input. Read in place
+    // from the process buffer (channel index resolved from the bus layout in prepareToPlay)
+    int keyChannel = 0;
+    int numKeyChannels = 1;
+    void updateDetectorKey();
+
+    juce::HeapBlock<char> hostScratchMemory, hostScratchDoubleMemory;
+    juce::dsp::AudioBlock<float> hostScratch;
+    juce::dsp::AudioBlock<double> hostScratchDouble;
+
+    template <typename SampleType>
+    SampleType* getHostScratch(HostScratchChannel channel) noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>) return hostScratchDouble.getChannelPointer((size_t) channel);
+        else return hostScratch.getChannelPointer((size_t) channel);
+    }
+
+    // The stages that touch host samples are templated on the processing precision
+    // (float or double, picked at compile time by the processBlock overload); the
+    // generated sub, envelopes and control ramps are rendered in float either way.
+    template <typename SampleType>
+    void processBlockInternal(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+    template <typename SampleType>
+    void renderSubBlock(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples, bool midiTrigger);
+
+    template <typename SampleType>
+    void renderBypassed(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples);
+
+    template <typename SampleType>
+    void feedBypassDelay(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples, bool readBack);
+
+    template <typename SampleType>
+    void processDetectorStage(const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples);
+
+    template <typename SampleType>
+    void processOutputStage(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples);
+
+    template <typename SampleType>
+    void captureOutputScope(const SampleType* output, int numSamples);
+
+    bool handleNoteMessage(const juce::MidiMessage& message);  // true = note-on (retrigger)
+    void processWetStage(int numSamples);
+
+    // Stages specialised at compile time on the per-block modes, so their loops carry no
+    // mode branches. selectRenderKernels() picks the instantiations once per block.
+    enum class OutputMode { normal, audition };
+
+    template <bool MidiMode>
+    void processVoiceStage(int numSamples, bool midiTrigger);
+
+    template <typename SampleType, OutputMode Mode>
+    void processMixStage(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples);
+
+    using VoiceStageKernel = void (NewProjectAudioProcessor::*)(int, bool);
+    template <typename SampleType>
+    using MixStageKernel = void (NewProjectAudioProcessor::*)(juce::AudioBuffer<SampleType>&, int, int);
+
+    VoiceStageKernel voiceStageKernel = nullptr;
+    MixStageKernel<float> mixStageKernel = nullptr;
+    MixStageKernel<double> mixStageKernelDouble = nullptr;
+    void selectRenderKernels();
+
+    template <typename SampleType>
+    static MixStageKernel<SampleType> getMixStageKernel(OutputMode mode) noexcept;
+
+    template <typename SampleType>
+    MixStageKernel<SampleType> getSelectedMixStageKernel() const noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>) return mixStageKernelDouble;
+        else return mixStageKernel;
+    }
+
     // --- 参数指针 (必须全部定义) ---
     std::atomic<float>* threshParam = nullptr;
     std::atomic<float>* ceilingParam = nullptr;
     std::atomic<float>* detReleaseParam = nullptr;
     std::atomic<float>* detScaleParam = nullptr;  // Detector Scale (50-400%)
+    std::atomic<float>* detModeParam = nullptr;   // Detector law choice (Peak/RMS/Hold/Hybrid)
+    std::atomic<float>* detWindowParam = nullptr; // RMS / hold window in ms
     std::atomic<float>* auditionParam = nullptr;
 
+    // Detector bands ([0] = THRESHOLD / F_FREQ / F_Q / B1_TRIG, [n] = B<n+1>_*)
+    std::array<std::atomic<float>*, DetectorBank::maxBands> bandThreshParams {}, bandFreqParams {}, bandQParams {}, bandTriggerParams {};
+
     std::atomic<float>* freqParam = nullptr;
     std::atomic<float>* qParam = nullptr;
     
@@ -194,6 +369,10 @@ private:
     std::atomic<float>* pDecParam = nullptr;
     std::atomic<float>* aAttParam = nullptr;
     std::atomic<float>* aDecParam = nullptr;
+    std::atomic<float>* envCurveParam = nullptr;  // Decay curve (0 = linear)
+    std::atomic<float>* lookaheadParam = nullptr;  // Dry delay in ms (0 = off)
+    std::atomic<float>* voicesParam = nullptr;  // Voice pool size choice (1/2/4/8)
+    std::atomic<float>* colorOversamplingParam = nullptr;  // COLOR layer rate choice (1x/2x/4x/8x)
     
     std::atomic<float>* duckParam = nullptr;
     std::atomic<float>* duckAttParam = nullptr;
@@ -204,13 +383,46 @@ private:
     std::atomic<float>* dryParam = nullptr;
     std::atomic<float>* monitorParam = nullptr; // 保留但可能不用
     std::atomic<float>* agmParam = nullptr;
-    std::atomic<float>* clipParam = nullptr;
+    std::atomic<float>* truePeakParam = nullptr;  // Output limiter: true-peak (4x) vs sample-peak detection
     std::atomic<float>* bypassParam = nullptr;  // Bypass control
     std::atomic<float>* midiModeParam = nullptr;  // MIDI Mode toggle
     std::atomic<float>* midiPitchParam = nullptr; // MIDI Pitch control
 
-    void updateFilterCoefficients(float freq, float Q);
-    void updateEnvelopeIncrements(float pAtt, float pDec, float aAtt, float aDec, float dAtt, float dDec, float cAtt, float cDec, float detRel);
+    // === Per-Block Parameter Snapshot ===
+    // Parameters are read from their atomics once per block. Derived coefficients
+    // are only recomputed when their inputs change, and gain-like values are
+    // ramped per sample (no atomics or dB conversions inside the sample loops).
+    struct BlockParameters
+    {
+        std::array<float, DetectorBank::maxBands> bandFreq {}, bandQ {}, bandThreshold {};
+        std::array<bool, DetectorBank::maxBands> bandTrigger {};
+        float ceiling = 0.0f, detRelease = 0.0f, detScale = 0.0f, detWindow = 0.0f;
+        int detLaw = 0;  // DetectorBank::Law
+        float startFreq = 0.0f, peakFreq = 0.0f, shape = 0.0f, noise = 0.0f;
+        float colorAmount = 0.0f, colorAtt = 0.0f, colorDec = 0.0f;
+        float pAtt = 0.0f, pDec = 0.0f, aAtt = 0.0f, aDec = 0.0f, envCurve = 0.0f;
+        float duck = 0.0f, duckAtt = 0.0f, duckDec = 0.0f;
+        float wet = 0.0f, dry = 0.0f, mix = 0.0f;
+        float lookahead = 0.0f;
+        int numVoices = VoicePool::maxVoices;
+        int colorOversampling = 0;  // Factor index (0 = 1x)
+        bool audition = false, agm = false, truePeak = false, bypass = false;
+        bool midiMode = false, midiPitch = false, hardRetrigger = true;
+        bool scopeTap = false, triggerTap = false, spectrumTap = false;  // Subscribed telemetry taps
+    };
+
+    BlockParameters blockParams;
+
+    juce::LinearSmoothedValue<float> detScaleSmoothed { 1.0f };
+    juce::LinearSmoothedValue<float> wetGainSmoothed { 1.0f };
+    juce::LinearSmoothedValue<float> duckDepthSmoothed { 0.0f };
+    juce::LinearSmoothedValue<float> mixSmoothed { 0.5f };
+    juce::LinearSmoothedValue<float> dryMixSmoothed { 1.0f };
+
+    void updateBlockParameters(bool forceUpdate);
+    void fillSmoothedRamps(int numSamples);
+
+    void updateEnvelopeSegments(float pAtt, float pDec, float aAtt, float aDec, float dAtt, float dDec, float cAtt, float cDec, float detRel, float curve);
 
     // A/B Compare - Parameter Storage
     struct ParameterSnapshot
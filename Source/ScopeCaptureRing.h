@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+    ScopeCaptureRing.h (SPLENTA V19.6 - 20261016.01)
+    Lock-Free Block Ring for the Detector / Output Scope
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Single-producer / single-consumer capture channel from the audio thread to the
+// scope. The audio thread fills fixed-size blocks (detector + output) and publishes
+// each full block by bumping a sequence counter with release ordering; the UI
+// acquires the counter and copies only the blocks it has not seen yet.
+//
+// The producer never waits. A consumer that falls more than numBlocks behind loses
+// the oldest blocks. Each slot is a seqlock: the producer marks it odd (release
+// fence) before refilling it and stamps it with the block's even sequence once
+// full; read() copies through relaxed atomics between two loads of that stamp and
+// reports failure unless both show the requested block (no torn reads).
+class ScopeCaptureRing
+{
+public:
+    static constexpr int blockSize = 256;    // Samples per published block
+    static constexpr int numBlocks = 256;    // Ring length (~1.4s @ 48kHz)
+
+    ScopeCaptureRing() : blocks((size_t) numBlocks) {}
+
+    // --- Audio thread ---
+
+    template <typename SampleType>
+    void push(const float* detector, const SampleType* output, int numSamples) noexcept
+    {
+        while (numSamples > 0)
+        {
+            const auto sequence = published.load(std::memory_order_relaxed);
+            auto& block = blocks[(size_t) (sequence & blockMask)];
+            const int run = juce::jmin(numSamples, blockSize - fill);
+
+            // Begin marker: no refill store may become visible before it
+            if (fill == 0)
+            {
+                block.stamp.store(sequence * 2 + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+
+            for (int i = 0; i < run; ++i)
+            {
+                block.detector[fill + i].store(detector[i], std::memory_order_relaxed);
+                block.output[fill + i].store((float) output[i], std::memory_order_relaxed);
+            }
+
+            fill += run;
+            detector += run;
+            output += run;
+            numSamples -= run;
+
+            if (fill == blockSize)
+            {
+                block.stamp.store(sequence * 2 + 2, std::memory_order_release);
+                published.store(sequence + 1, std::memory_order_release);
+                fill = 0;
+            }
+        }
+    }
+
+    // Samples pushed so far: the stream index of the next sample (timestamps)
+    juce::int64 getNumPushed() const noexcept
+    {
+        return (juce::int64) published.load(std::memory_order_relaxed) * blockSize + fill;
+    }
+
+    // --- UI thread ---
+
+    // Number of blocks published so far (block indices run 0 .. count - 1)
+    juce::uint64 getNumPublished() const noexcept { return published.load(std::memory_order_acquire); }
+
+    // Copies block blockIndex (blockSize samples per destination). False if it is not
+    // published yet or has already been overwritten.
+    bool read(juce::uint64 blockIndex, float* detectorDest, float* outputDest) const noexcept
+    {
+        if (blockIndex >= getNumPublished())
+            return false;
+
+        const auto& block = blocks[(size_t) (blockIndex & blockMask)];
+        const auto expected = blockIndex * 2 + 2;
+        if (block.stamp.load(std::memory_order_acquire) != expected)
+            return false;
+
+        for (int i = 0; i < blockSize; ++i)
+        {
+            detectorDest[i] = block.detector[i].load(std::memory_order_relaxed);
+            outputDest[i] = block.output[i].load(std::memory_order_relaxed);
+        }
+
+        // A refill that started during the copy has changed the stamp by now
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return block.stamp.load(std::memory_order_relaxed) == expected;
+    }
+
+private:
+    static constexpr juce::uint64 blockMask = (juce::uint64) numBlocks - 1;
+    static_assert ((numBlocks & (numBlocks - 1)) == 0, "numBlocks must be a power of two");
+
+    struct Block
+    {
+        std::atomic<juce::uint64> stamp { 0 };  // 2b + 1 while filling block b, 2b + 2 once full
+        std::atomic<float> detector[blockSize];
+        std::atomic<float> output[blockSize];
+    };
+
+    std::vector<Block> blocks;
+    std::atomic<juce::uint64> published { 0 };
+    int fill = 0;  // Samples in the block being filled (audio thread only)
+};
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+    SegmentEnvelope.cpp (SPLENTA V19.6 - 20261016.01)
+    Attack/Decay Envelope Rendered in Whole Segment Runs
+  ==============================================================================
+*/
+
+#include "SegmentEnvelope.h"
+
+namespace
+{
+    // Curve 0..1 -> overshoot past the segment end point (small = strongly exponential)
+    inline float getOvershoot(float curve) noexcept
+    {
+        return std::pow(10.0f, -3.0f * curve);  // 1.0 (gentle) .. 0.001 (-60dB knee)
+    }
+}
+
+SegmentEnvelope::Segment SegmentEnvelope::makeSegment(float lengthInSamples, float curve, bool rising) noexcept
+{
+    const float length = juce::jmax(1.0f, lengthInSamples);
+    const float endPoint = rising ? 1.0f : 0.0f;
+    const float direction = rising ? 1.0f : -1.0f;
+    Segment segment;
+
+    if (curve <= 0.0f)
+    {
+        // Linear: full-scale travel in `length` samples
+        segment.add = direction / length;
+        segment.target = endPoint;
+    }
+    else
+    {
+        // Exponential towards an overshoot target; full-scale travel still takes `length` samples
+        const float overshoot = getOvershoot(juce::jmin(1.0f, curve));
+        segment.target = endPoint + direction * overshoot;
+        segment.mul = std::pow(overshoot / (1.0f + overshoot), 1.0f / length);
+        segment.add = segment.target * (1.0f - segment.mul);
+    }
+
+    return segment;
+}
+
+void SegmentEnvelope::setAttack(float lengthInSamples, float curve) noexcept
+{
+    attackShape = { juce::jmax(1.0f, lengthInSamples), juce::jlimit(0.0f, 1.0f, curve) };
+    segmentDirty = true;
+}
+
+void SegmentEnvelope::setDecay(float lengthInSamples, float curve) noexcept
+{
+    decayShape = { juce::jmax(1.0f, lengthInSamples), juce::jlimit(0.0f, 1.0f, curve) };
+    segmentDirty = true;
+}
+
+void SegmentEnvelope::retrigger(float keepFactor) noexcept
+{
+    value *= keepFactor;
+    stage = Stage::attack;
+    segmentDirty = true;
+}
+
+void SegmentEnvelope::reset() noexcept
+{
+    value = 0.0f;
+    stage = Stage::done;
+    segmentDirty = true;
+}
+
+void SegmentEnvelope::hold(float* dest, int numSamples) const noexcept
+{
+    std::fill(dest, dest + numSamples, value);
+}
+
+int SegmentEnvelope::render(float* dest, int numSamples) noexcept
+{
+    if (stage == Stage::done)
+    {
+        hold(dest, numSamples);
+        return 0;
+    }
+
+    int pos = 0;
+
+    while (pos < numSamples)
+    {
+        if (segmentDirty)
+            prepareSegment();
+
+        // Samples that certainly stay inside the segment -> closed-form run
+        const int run = juce::jmin(getSafeRunLength(), numSamples - pos);
+        renderRun(dest + pos, run);
+        pos += run;
+
+        if (pos == numSamples)
+            break;
+
+        // Boundary (or near-boundary) sample: scalar step with clamp/transition
+        stepBoundary();
+        dest[pos++] = value;
+
+        if (stage == Stage::done)
+        {
+            hold(dest + pos, numSamples - pos);
+            return pos;
+        }
+    }
+
+    return numSamples;
+}
+
+void SegmentEnvelope::prepareSegment() noexcept
+{
+    const bool rising = (stage == Stage::attack);
+    const auto& shape = rising ? attackShape : decayShape;
+    const auto segment = makeSegment(shape.length, shape.curve, rising);
+    mul = segment.mul;
+    add = segment.add;
+    target = segment.target;
+
+    // Lane j holds the value after (j + 1) steps: y * mul^(j+1) + add * (1 + mul + ... + mul^j)
+    float mulPower = 1.0f, addSum = 0.0f;
+    for (int j = 0; j < numLanes; ++j)
+    {
+        addSum += add * mulPower;
+        mulPower *= mul;
+        laneMul[(size_t) j] = mulPower;
+        laneAdd[(size_t) j] = addSum;
+    }
+
+    segmentDirty = false;
+}
+
+int SegmentEnvelope::getSafeRunLength() const noexcept
+{
+    // Steps k with the value still strictly inside the segment, minus one sample of margin
+    double steps = 0.0;
+
+    if (mul == 1.0f)
+    {
+        const float distance = (stage == Stage::attack) ? (1.0f - value) : value;
+        steps = distance / std::abs(add);
+    }
+    else
+    {
+        // y_k = target + (y - target) * mul^k reaches the end point when
+        // mul^k = (end - target) / (y - target)
+        const float endPoint = (stage == Stage::attack) ? 1.0f : 0.0f;
+        const double ratio = (double) (endPoint - target) / (double) (value - target);
+        if (ratio <= 0.0 || ratio >= 1.0)
+            return 0;
+
+        steps = std::log(ratio) / std::log((double) mul);
+    }
+
+    return (int) juce::jlimit(0.0, (double) std::numeric_limits<int>::max() / 2, std::floor(steps) - 1.0);
+}
+
+void SegmentEnvelope::renderRun(float* dest, int numSamples) noexcept
+{
+    float y = value;
+    int i = 0;
+
+    // Whole lane groups: independent lanes -> vector FMAs
+    for (; i + numLanes <= numSamples; i += numLanes)
+    {
+        for (int j = 0; j < numLanes; ++j)
+            dest[i + j] = y * laneMul[(size_t) j] + laneAdd[(size_t) j];
+
+        y = dest[i + numLanes - 1];
+    }
+
+    // Remaining samples
+    for (; i < numSamples; ++i)
+    {
+        y = y * mul + add;
+        dest[i] = y;
+    }
+
+    value = y;
+}
+
+void SegmentEnvelope::stepBoundary() noexcept
+{
+    value = value * mul + add;
+
+    if (stage == Stage::attack && value >= 1.0f)
+    {
+        value = 1.0f;
+        stage = Stage::decay;
+        segmentDirty = true;
+    }
+    else if (stage == Stage::decay && value <= 0.0f)
+    {
+        value = 0.0f;
+        stage = Stage::done;
+        segmentDirty = true;
+    }
+}
@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+    SegmentEnvelope.h (SPLENTA V19.6 - 20261016.01)
+    Attack/Decay Envelope Rendered in Whole Segment Runs
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Attack (0 -> 1) then decay (1 -> 0) envelope that renders whole runs at once.
+// Every segment is the recurrence y[n+1] = y[n] * mul + add:
+//   linear      mul = 1,  add = +-1/N
+//   exponential mul = c,  add = target * (1 - c)   (target overshoots the end point)
+// so curved segments cost the same per sample as linear ones. Inside a segment
+// the run is rendered a lane group at a time from closed-form lane tables
+// (vectorisable); only the sample that crosses a boundary is stepped in scalar.
+class SegmentEnvelope
+{
+public:
+    enum class Stage { attack, decay, done };
+
+    static constexpr int numLanes = 8;
+
+    // One segment of the recurrence; target is where the curve aims (past the end point if curved)
+    struct Segment
+    {
+        float mul = 1.0f, add = 0.0f, target = 0.0f;
+    };
+
+    // Full-scale segment: rising = attack (0 -> 1), otherwise decay (1 -> 0)
+    static Segment makeSegment(float lengthInSamples, float curve, bool rising) noexcept;
+
+    // Segment lengths in samples; curve 0 = linear, 1 = strongly exponential
+    void setAttack(float lengthInSamples, float curve = 0.0f) noexcept;
+    void setDecay(float lengthInSamples, float curve = 0.0f) noexcept;
+
+    // Restart the attack, keeping a fraction of the current value (0 = hard reset)
+    void retrigger(float keepFactor) noexcept;
+
+    // Idle at zero
+    void reset() noexcept;
+
+    // Renders numSamples. If the decay finishes inside this call, returns the number of
+    // samples up to and including the finishing one (the rest hold 0); otherwise numSamples.
+    int render(float* dest, int numSamples) noexcept;
+
+    // Fills with the current value without advancing
+    void hold(float* dest, int numSamples) const noexcept;
+
+    float getValue() const noexcept { return value; }
+    Stage getStage() const noexcept { return stage; }
+    bool isDone() const noexcept { return stage == Stage::done; }
+
+private:
+    struct SegmentShape
+    {
+        float length = 1.0f;
+        float curve = 0.0f;
+    };
+
+    void prepareSegment() noexcept;
+    int getSafeRunLength() const noexcept;
+    void renderRun(float* dest, int numSamples) noexcept;
+    void stepBoundary() noexcept;
+
+    SegmentShape attackShape, decayShape;
+    Stage stage = Stage::done;
+    float value = 0.0f;
+
+    // Active segment: recurrence coefficients, overshoot target and lane tables
+    float mul = 1.0f, add = 0.0f, target = 0.0f;
+    std::array<float, numLanes> laneMul {}, laneAdd {};
+    bool segmentDirty = true;
+};
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+    SpectrumAnalyser.cpp (SPLENTA V19.6 - 20261016.01)
+    Background Spectrum Analysis for the FFT Tap
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyser.h"
+
+namespace
+{
+    constexpr float levelSmoothing = 0.3f;          // Per-frame averaging weight of the new level
+    constexpr double peakHoldSeconds = 0.5;
+    constexpr double peakDecayDbPerSecond = 24.0;
+}
+
+SpectrumAnalyser::SpectrumAnalyser()
+    : juce::Thread("Spectrum Analyser"),
+      ring((size_t) ringSize, 0.0f),
+      timeline((size_t) fftSize, 0.0f),
+      fftBuffer((size_t) fftSize * 2, 0.0f)
+{
+    current.level.fill(floorDb);
+    current.peak.fill(floorDb);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    stopThread(1000);
+}
+
+void SpectrumAnalyser::addDisplay()
+{
+    if (numDisplays++ == 0)
+        startThread();
+}
+
+void SpectrumAnalyser::removeDisplay()
+{
+    jassert (numDisplays > 0);
+    if (--numDisplays == 0)
+        stopThread(1000);
+}
+
+void SpectrumAnalyser::push(const float* samples, int numSamples) noexcept
+{
+    // Drops what does not fit (the worker fell behind); never blocks
+    int start1, size1, start2, size2;
+    ringFifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    std::copy(samples, samples + size1, ring.begin() + start1);
+    std::copy(samples + size1, samples + size1 + size2, ring.begin() + start2);
+
+    ringFifo.finishedWrite(size1 + size2);
+}
+
+bool SpectrumAnalyser::getLatestFrame(Frame& dest) noexcept
+{
+    if ((middleSlot.load(std::memory_order_relaxed) & newFrameBit) != 0)
+    {
+        // Acquire pairs with the worker's publish, so the frame is complete
+        frontIndex = middleSlot.exchange(frontIndex, std::memory_order_acq_rel) & ~newFrameBit;
+        hasFrontFrame = true;
+    }
+
+    if (! hasFrontFrame)
+        return false;
+
+    dest = frames[frontIndex];
+    return true;
+}
+
+void SpectrumAnalyser::run()
+{
+    // Start from silence: drop samples left over from an earlier session
+    ringFifo.finishedRead(ringFifo.getNumReady());
+    std::fill(timeline.begin(), timeline.end(), 0.0f);
+    current.level.fill(floorDb);
+    current.peak.fill(floorDb);
+    holdCounters.fill(0);
+
+    while (!threadShouldExit())
+    {
+        const double rate = sampleRate.load();
+        if (rate != ratesSampleRate)
+            updateRates(rate);
+
+        if (ringFifo.getNumReady() < hopSize)
+        {
+            wait(5);
+            continue;
+        }
+
+        // Slide the analysis window by one hop
+        std::copy(timeline.begin() + hopSize, timeline.end(), timeline.begin());
+
+        int start1, size1, start2, size2;
+        ringFifo.prepareToRead(hopSize, start1, size1, start2, size2);
+
+        auto* dest = timeline.data() + fftSize - hopSize;
+        std::copy(ring.begin() + start1, ring.begin() + start1 + size1, dest);
+        std::copy(ring.begin() + start2, ring.begin() + start2 + size2, dest + size1);
+        ringFifo.finishedRead(size1 + size2);
+
+        analyseFrame();
+    }
+}
+
+void SpectrumAnalyser::updateRates(double newSampleRate)
+{
+    ratesSampleRate = newSampleRate;
+
+    // Log-spaced band edges -> FFT bins (bands above Nyquist get no bins)
+    const double binHz = newSampleRate / fftSize;
+    for (int b = 0; b <= numBands; ++b)
+    {
+        const double edge = minFrequency * std::pow((double) maxFrequency / minFrequency, (double) b / numBands);
+        bandBins[(size_t) b] = juce::jlimit(1, fftSize / 2 + 1, (int) std::lround(edge / binHz));
+    }
+
+    const double framesPerSecond = newSampleRate / hopSize;
+    holdFrames = (int) std::lround(peakHoldSeconds * framesPerSecond);
+    decayPerFrame = (float) (peakDecayDbPerSecond / framesPerSecond);
+}
+
+void SpectrumAnalyser::analyseFrame()
+{
+    std::copy(timeline.begin(), timeline.end(), fftBuffer.begin());
+    window.multiplyWithWindowingTable(fftBuffer.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftBuffer.data());
+
+    // Normalised Hann window: a full-scale sine peaks at fftSize / 2
+    const float amplitudeScale = 2.0f / (float) fftSize;
+
+    for (int b = 0; b < numBands; ++b)
+    {
+        // Bands narrower than a bin read the nearest one
+        const int firstBin = bandBins[(size_t) b];
+        const int lastBin = juce::jmin(fftSize / 2 + 1, juce::jmax(firstBin + 1, bandBins[(size_t) b + 1]));
+
+        float magnitude = 0.0f;
+        for (int bin = firstBin; bin < lastBin; ++bin)
+            magnitude = juce::jmax(magnitude, fftBuffer[(size_t) bin]);
+
+        const float db = juce::Decibels::gainToDecibels(magnitude * amplitudeScale, floorDb);
+
+        auto& level = current.level[(size_t) b];
+        level += (db - level) * levelSmoothing;
+
+        // Peak hold: hold for peakHoldSeconds, then fall linearly in dB
+        auto& peak = current.peak[(size_t) b];
+        auto& hold = holdCounters[(size_t) b];
+        if (level >= peak)
+        {
+            peak = level;
+            hold = holdFrames;
+        }
+        else if (hold > 0)
+        {
+            --hold;
+        }
+        else
+        {
+            peak = juce::jmax(level, peak - decayPerFrame);
+        }
+    }
+
+    // Fill the back buffer, then swap it into the middle slot. An unread frame
+    // that comes back is simply overwritten next time.
+    frames[backIndex] = current;
+    backIndex = middleSlot.exchange(backIndex | newFrameBit, std::memory_order_acq_rel) & ~newFrameBit;
+}
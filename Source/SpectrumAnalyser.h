@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+    SpectrumAnalyser.h (SPLENTA V19.6 - 20261016.01)
+    Background Spectrum Analysis for the FFT Tap
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Spectrum pipeline with no FFT work on the audio or message thread.
+//
+// The audio thread only copies blocks into a lock-free sample ring (push), and
+// only while the spectrum telemetry tap is subscribed. A worker thread takes hops of hopSize samples
+// from the ring and runs a Hann-windowed FFT over the last fftSize samples (75%
+// overlap). It folds the bins into log-spaced bands (20 Hz - 20 kHz) and keeps an
+// averaged level and a peak hold (hold, then linear dB decay) per band.
+//
+// Finished frames reach the display through a triple buffer. The worker fills its
+// back buffer and swaps it into the middle slot with a "new" bit. getLatestFrame()
+// swaps the middle slot for its front buffer when that bit is set, then copies
+// the front. Each buffer has one owner at a time, so no frame is ever read while
+// it is being written.
+class SpectrumAnalyser : private juce::Thread
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 4;
+    static constexpr int numBands = 96;
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float maxFrequency = 20000.0f;
+    static constexpr float floorDb = -96.0f;
+
+    struct Frame
+    {
+        std::array<float, numBands> level;  // Averaged band level (dBFS)
+        std::array<float, numBands> peak;   // Peak hold (dBFS)
+    };
+
+    SpectrumAnalyser();
+    ~SpectrumAnalyser() override;
+
+    void setSampleRate(double newSampleRate) noexcept { sampleRate.store(newSampleRate); }
+
+    // Display lifetime (message thread): the worker runs only while at least one
+    // display is attached
+    void addDisplay();
+    void removeDisplay();
+
+    // --- Audio thread ---
+    void push(const float* samples, int numSamples) noexcept;
+
+    // --- Display (message thread only: the front buffer has a single reader) ---
+    // Copies the newest frame; false before the first frame
+    bool getLatestFrame(Frame& dest) noexcept;
+
+private:
+    void run() override;
+    void analyseFrame();
+    void updateRates(double newSampleRate);
+
+    // Audio thread -> worker
+    static constexpr int ringSize = fftSize * 8;
+    std::vector<float> ring;
+    juce::AbstractFifo ringFifo { ringSize };
+    std::atomic<double> sampleRate { 48000.0 };
+    int numDisplays = 0;
+
+    // Worker state
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, true };
+    std::vector<float> timeline;    // Last fftSize samples
+    std::vector<float> fftBuffer;   // 2 * fftSize (in-place real FFT)
+    std::array<int, numBands + 1> bandBins {};
+    Frame current;
+    std::array<int, numBands> holdCounters {};
+    double ratesSampleRate = 0.0;
+    int holdFrames = 0;
+    float decayPerFrame = 0.0f;
+
+    // Worker -> display (triple buffer: worker owns backIndex, the display owns
+    // frontIndex, middleSlot holds the third index plus newFrameBit once published)
+    static constexpr int newFrameBit = 4;
+    Frame frames[3];
+    int backIndex = 0;
+    std::atomic<int> middleSlot { 1 };
+    int frontIndex = 2;
+    bool hasFrontFrame = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyser)
+};
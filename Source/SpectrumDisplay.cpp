@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+    SpectrumDisplay.cpp (SPLENTA V19.6 - 20261016.01)
+    Log-Frequency Spectrum Overlay (Level + Peak Hold)
+  ==============================================================================
+*/
+
+#include "SpectrumDisplay.h"
+
+SpectrumDisplay::SpectrumDisplay(SpectrumAnalyser& analyserToUse, TelemetryTaps& taps)
+    : analyser(analyserToUse),
+      spectrumTap(taps, TelemetryTaps::spectrum)
+{
+    palette = ThemePalette::getPaletteByIndex(0);  // Default Bronze theme
+    setInterceptsMouseClicks(false, false);        // Overlay only
+    setOpaque(false);
+
+    startTimerHz(30);
+}
+
+SpectrumDisplay::~SpectrumDisplay()
+{
+    stopTimer();
+    setAttached(false);
+}
+
+void SpectrumDisplay::setAttached(bool shouldBeAttached)
+{
+    if (shouldBeAttached == spectrumTap.isActive())
+        return;
+
+    // The worker starts before the audio thread feeds it and stops after the feed ends
+    if (shouldBeAttached)
+    {
+        analyser.addDisplay();
+        spectrumTap.setActive(true);
+    }
+    else
+    {
+        spectrumTap.setActive(false);
+        analyser.removeDisplay();
+    }
+}
+
+void SpectrumDisplay::visibilityChanged()
+{
+    setAttached(isShowing());
+}
+
+void SpectrumDisplay::parentHierarchyChanged()
+{
+    setAttached(isShowing());
+}
+
+void SpectrumDisplay::setPalette(const ThemePalette& newPalette)
+{
+    palette = newPalette;
+    repaint();
+}
+
+void SpectrumDisplay::timerCallback()
+{
+    // Also catches an ancestor being hidden, which sends this view no callback
+    setAttached(isShowing());
+    if (!spectrumTap.isActive())
+        return;
+
+    if (analyser.getLatestFrame(frame))
+    {
+        hasFrame = true;
+        repaint();
+    }
+}
+
+void SpectrumDisplay::paint(juce::Graphics& g)
+{
+    if (!hasFrame)
+        return;
+
+    const float width = (float)getWidth();
+    const float height = (float)getHeight();
+    const float xStep = width / (float)(SpectrumAnalyser::numBands - 1);
+
+    // dBFS -> Y (floor at the bottom, 0 dB at the top)
+    auto toY = [height](float db)
+    {
+        return juce::jmap(juce::jlimit(SpectrumAnalyser::floorDb, 0.0f, db), SpectrumAnalyser::floorDb, 0.0f, height, 0.0f);
+    };
+
+    // Averaged level: filled curve
+    juce::Path levelPath;
+    levelPath.startNewSubPath(0.0f, height);
+    for (int b = 0; b < SpectrumAnalyser::numBands; ++b)
+        levelPath.lineTo((float)b * xStep, toY(frame.level[(size_t)b]));
+    levelPath.lineTo(width, height);
+    levelPath.closeSubPath();
+
+    g.setColour(palette.accent.withAlpha(0.18f));
+    g.fillPath(levelPath);
+
+    // Peak hold: thin line on top
+    juce::Path peakPath;
+    peakPath.startNewSubPath(0.0f, toY(frame.peak[0]));
+    for (int b = 1; b < SpectrumAnalyser::numBands; ++b)
+        peakPath.lineTo((float)b * xStep, toY(frame.peak[(size_t)b]));
+
+    g.setColour(palette.accent.withAlpha(0.6f));
+    g.strokePath(peakPath, juce::PathStrokeType(1.0f));
+}
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+    SpectrumDisplay.h (SPLENTA V19.6 - 20261016.01)
+    Log-Frequency Spectrum Overlay (Level + Peak Hold)
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Theme.h"
+#include "SpectrumAnalyser.h"
+#include "TelemetryTaps.h"
+
+// Draws the analyser's newest frame: averaged band levels as a filled curve and the
+// peak hold as a line. Only copies frames; all FFT work stays on the analyser thread.
+// Attaches to the analyser and subscribes to the spectrum tap only while showing, so
+// neither the feed nor the analysis runs behind a hidden view or a closed editor.
+class SpectrumDisplay : public juce::Component,
+                        public juce::Timer
+{
+public:
+    SpectrumDisplay(SpectrumAnalyser& analyserToUse, TelemetryTaps& taps);
+    ~SpectrumDisplay() override;
+
+    void paint(juce::Graphics& g) override;
+    void timerCallback() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+
+    void setPalette(const ThemePalette& newPalette);
+
+private:
+    SpectrumAnalyser& analyser;
+    TelemetryTaps::Subscription spectrumTap;
+    void setAttached(bool shouldBeAttached);
+
+    SpectrumAnalyser::Frame frame;
+    bool hasFrame = false;
+    ThemePalette palette;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumDisplay)
+};
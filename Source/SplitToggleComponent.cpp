@@ -1,7 +1,7 @@
 /*
   ==============================================================================
     SplitToggleComponent.cpp (SPLENTA V19.0 - 20251218.01)
-    Batch 06: Split Dual Toggle (Diagonal Split Button with A/C)
+    Batch 06: Split Dual Toggle (Diagonal Split Button with A/T)
   ==============================================================================
 */
 
@@ -18,11 +18,11 @@ SplitToggleComponent::SplitToggleComponent(juce::AudioProcessorValueTreeState& a
 
     // Get initial states
     auto* agmParam = apvts.getRawParameterValue("AGM_MODE");
-    auto* clipParam = apvts.getRawParameterValue("SOFT_CLIP");
+    auto* truePeakParam = apvts.getRawParameterValue("TRUE_PEAK");
     if (agmParam != nullptr)
         agmState = agmParam->load() > 0.5f;
-    if (clipParam != nullptr)
-        clipState = clipParam->load() > 0.5f;
+    if (truePeakParam != nullptr)
+        truePeakState = truePeakParam->load() > 0.5f;
 }
 
 SplitToggleComponent::~SplitToggleComponent()
@@ -43,15 +43,15 @@ void SplitToggleComponent::paint(juce::Graphics& g)
 
     // Get current states
     auto* agmParam = apvts.getRawParameterValue("AGM_MODE");
-    auto* clipParam = apvts.getRawParameterValue("SOFT_CLIP");
+    auto* truePeakParam = apvts.getRawParameterValue("TRUE_PEAK");
     if (agmParam != nullptr)
         agmState = agmParam->load() > 0.5f;
-    if (clipParam != nullptr)
-        clipState = clipParam->load() > 0.5f;
+    if (truePeakParam != nullptr)
+        truePeakState = truePeakParam->load() > 0.5f;
 
     // Use more subtle accent-based colors (less rotation for consistency)
     juce::Colour colorA = palette.accent.withRotatedHue(-0.03f);  // AGM (slightly cooler)
-    juce::Colour colorB = palette.accent.withRotatedHue(0.03f);   // Clip (slightly warmer)
+    juce::Colour colorB = palette.accent.withRotatedHue(0.03f);   // True peak (slightly warmer)
 
     // Create rounded rectangle path for clipping
     const float cornerRadius = 6.0f;
@@ -71,7 +71,7 @@ void SplitToggleComponent::paint(juce::Graphics& g)
     g.fillPath(topTriangle);
     g.restoreState();
 
-    // Draw right-bottom triangle (Soft Clip) with subtle fill
+    // Draw right-bottom triangle (True Peak) with subtle fill
     juce::Path bottomTriangle;
     bottomTriangle.startNewSubPath(w, 0);
     bottomTriangle.lineTo(w, h);
@@ -80,7 +80,7 @@ void SplitToggleComponent::paint(juce::Graphics& g)
 
     g.saveState();
     g.reduceClipRegion(clipPath);
-    g.setColour(clipState ? colorB.withAlpha(0.2f) : juce::Colours::white.withAlpha(0.03f));
+    g.setColour(truePeakState ? colorB.withAlpha(0.2f) : juce::Colours::white.withAlpha(0.03f));
     g.fillPath(bottomTriangle);
     g.restoreState();
 
@@ -99,29 +99,36 @@ void SplitToggleComponent::paint(juce::Graphics& g)
     g.setColour(agmState ? colorA.brighter(0.3f) : juce::Colours::white.withAlpha(0.5f));
     g.drawText("A", bounds.reduced(4.0f).removeFromTop(h * 0.5f), juce::Justification::centredTop);
 
-    // C for Clip (bottom-right)
-    g.setColour(clipState ? colorB.brighter(0.3f) : juce::Colours::white.withAlpha(0.5f));
-    g.drawText("C", bounds.reduced(4.0f).removeFromBottom(h * 0.5f), juce::Justification::centredBottom);
+    // T for True Peak (bottom-right)
+    g.setColour(truePeakState ? colorB.brighter(0.3f) : juce::Colours::white.withAlpha(0.5f));
+    g.drawText("T", bounds.reduced(4.0f).removeFromBottom(h * 0.5f), juce::Justification::centredBottom);
 }
 
 void SplitToggleComponent::resized()
 {
 }
 
-void SplitToggleComponent::mouseDown(const juce::MouseEvent& event)
+bool SplitToggleComponent::isInTopLeft(juce::Point<float> position) const
 {
-    float x = event.position.x;
-    float y = event.position.y;
     float w = (float)getWidth();
     float h = (float)getHeight();
 
     // Diagonal line equation: from (0, h) to (w, 0)
     // Line: y = h - (h/w) * x
     // Point is in top-left triangle if: y < h - (h/w) * x
+    return position.y < (h - (h / w) * position.x);
+}
 
-    bool clickedTopLeft = (y < (h - (h / w) * x));
+juce::String SplitToggleComponent::getTooltip()
+{
+    return isInTopLeft(getMouseXYRelative().toFloat())
+        ? "A: Auto Gain (loudness-matched output)"
+        : "T: True Peak (4x oversampled peak detection in the output limiter)";
+}
 
-    if (clickedTopLeft)
+void SplitToggleComponent::mouseDown(const juce::MouseEvent& event)
+{
+    if (isInTopLeft(event.position))
     {
         // Toggle AGM
         auto* param = apvts.getParameter("AGM_MODE");
@@ -134,13 +141,13 @@ void SplitToggleComponent::mouseDown(const juce::MouseEvent& event)
     }
     else
     {
-        // Toggle Soft Clip
-        auto* param = apvts.getParameter("SOFT_CLIP");
+        // Toggle true-peak limiting
+        auto* param = apvts.getParameter("TRUE_PEAK");
         if (param != nullptr)
         {
-            bool newState = !clipState;
+            bool newState = !truePeakState;
             param->setValueNotifyingHost(newState ? 1.0f : 0.0f);
-            clipState = newState;
+            truePeakState = newState;
         }
     }
 
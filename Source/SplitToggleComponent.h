@@ -10,7 +10,8 @@
 #include <JuceHeader.h>
 #include "Theme.h"
 
-class SplitToggleComponent : public juce::Component
+class SplitToggleComponent : public juce::Component,
+                             public juce::TooltipClient
 {
 public:
     SplitToggleComponent(juce::AudioProcessorValueTreeState& apvts);
@@ -19,6 +20,7 @@ public:
     void paint(juce::Graphics& g) override;
     void resized() override;
     void mouseDown(const juce::MouseEvent& event) override;
+    juce::String getTooltip() override;
 
     // Set theme palette for color updates
     void setPalette(const ThemePalette& newPalette);
@@ -28,7 +30,10 @@ private:
 
     ThemePalette palette;
     bool agmState = false;
-    bool clipState = false;
+    bool truePeakState = false;
+
+    // Top-left half = AGM, bottom-right half = true peak
+    bool isInTopLeft(juce::Point<float> position) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SplitToggleComponent)
 };
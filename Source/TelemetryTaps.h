@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+    TelemetryTaps.h (SPLENTA V19.6 - 20261016.01)
+    On-Demand Visualisation Streams (Subscriber Registry)
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Registry of the streams the processor can capture for visualisers. A view subscribes
+// to the taps it draws while it is showing; the audio thread snapshots isActive()
+// once per block and skips every capture nobody subscribed to, so an instance with
+// its editor closed does no visualisation work at all.
+class TelemetryTaps
+{
+public:
+    enum Tap
+    {
+        scope = 0,       // Detector / output blocks (ScopeCaptureRing)
+        triggerEvents,   // Timestamped hits (TriggerEventQueue)
+        spectrum,        // Wet + input feed for the SpectrumAnalyser
+        numTaps
+    };
+
+    // Message thread
+    void subscribe(Tap tap) noexcept { subscribers[tap].fetch_add(1, std::memory_order_relaxed); }
+
+    void unsubscribe(Tap tap) noexcept
+    {
+        jassert (subscribers[tap].load(std::memory_order_relaxed) > 0);
+        subscribers[tap].fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Audio thread
+    bool isActive(Tap tap) const noexcept { return subscribers[tap].load(std::memory_order_relaxed) > 0; }
+
+    // One view's hold on a tap: follows setActive() and is released on destruction, so a
+    // view torn down with the editor can never leave its tap running
+    class Subscription
+    {
+    public:
+        Subscription(TelemetryTaps& tapsToUse, Tap tapToHold) noexcept : taps(tapsToUse), tap(tapToHold) {}
+        ~Subscription() { setActive(false); }
+
+        // Returns true if the state changed
+        bool setActive(bool shouldBeActive) noexcept
+        {
+            if (shouldBeActive == active)
+                return false;
+
+            active = shouldBeActive;
+            if (active) taps.subscribe(tap);
+            else        taps.unsubscribe(tap);
+            return true;
+        }
+
+        bool isActive() const noexcept { return active; }
+
+    private:
+        TelemetryTaps& taps;
+        const Tap tap;
+        bool active = false;
+
+        JUCE_DECLARE_NON_COPYABLE (Subscription)
+    };
+
+private:
+    std::atomic<int> subscribers[numTaps] {};
+};
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+    TriggerEventQueue.h (SPLENTA V19.6 - 20261016.01)
+    Timestamped Trigger Events from the Audio Thread to the UI
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// One detected hit (a new voice start), stamped with its exact sample
+struct TriggerEvent
+{
+    enum class Source { audio = 0, midi };
+
+    juce::int64 position = 0;   // Sample index in the scope capture stream (ScopeCaptureRing)
+    float level = 0.0f;         // Detector envelope (audio) or note velocity (MIDI)
+    Source source = Source::audio;
+};
+
+// Lock-free single-producer / single-consumer FIFO of trigger events. The audio
+// thread pushes every hit (dropped, never blocking, if the UI stops draining);
+// the UI pops whatever arrived since its last frame.
+class TriggerEventQueue
+{
+public:
+    static constexpr int capacity = 256;
+
+    // Audio thread
+    bool push(const TriggerEvent& event) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+        if (size1 > 0)
+            events[(size_t) start1] = event;
+
+        fifo.finishedWrite(size1);
+        return size1 > 0;
+    }
+
+    // UI thread: copies up to maxEvents, oldest first; returns the number copied
+    int pop(TriggerEvent* dest, int maxEvents) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(maxEvents, start1, size1, start2, size2);
+
+        std::copy(events.begin() + start1, events.begin() + start1 + size1, dest);
+        std::copy(events.begin() + start2, events.begin() + start2 + size2, dest + size1);
+
+        fifo.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+
+private:
+    std::array<TriggerEvent, capacity> events;
+    juce::AbstractFifo fifo { capacity };
+};
@@ -0,0 +1,300 @@
+/*
+  ==============================================================================
+    VoicePool.cpp (SPLENTA V19.6 - 20261016.01)
+    Preallocated Sub Voices in Structure-of-Arrays Layout
+  ==============================================================================
+*/
+
+#include "VoicePool.h"
+
+namespace
+{
+    // Dirty oscillator (harmonic-rich layer): soft clip + asymmetric (even) harmonics
+    inline float shapeColor(float cleanOsc, float drive, float evenHarmonics) noexcept
+    {
+        float dirtyOsc = cleanOsc * drive;
+        dirtyOsc = dirtyOsc / (1.0f + std::abs(dirtyOsc));
+        return dirtyOsc + evenHarmonics * dirtyOsc * dirtyOsc;
+    }
+}
+
+void VoicePool::setEnvelopeSegments(float pitchAtt, float pitchDec, float ampAtt, float ampDec,
+                                    float colorAtt, float colorDec, float curve) noexcept
+{
+    const float attacks[numEnvelopes] = { pitchAtt, ampAtt, colorAtt };
+    const float decays[numEnvelopes] = { pitchDec, ampDec, colorDec };
+
+    for (int e = 0; e < numEnvelopes; ++e)
+    {
+        attackSegment[e] = SegmentEnvelope::makeSegment(attacks[e], 0.0f, true);
+        decaySegment[e] = SegmentEnvelope::makeSegment(decays[e], curve, false);
+
+        // Running segments continue from their current value with the new shape
+        auto& lanes = env[e];
+        for (int v = 0; v < maxVoices; ++v)
+        {
+            if (lanes.direction[v] != 0.0f)
+            {
+                const auto& segment = lanes.direction[v] > 0.0f ? attackSegment[e] : decaySegment[e];
+                lanes.mul[v] = segment.mul;
+                lanes.add[v] = segment.add;
+            }
+        }
+    }
+}
+
+void VoicePool::reset() noexcept
+{
+    for (auto& lanes : env)
+    {
+        for (int v = 0; v < maxVoices; ++v)
+        {
+            lanes.value[v] = 0.0f;
+            lanes.direction[v] = 0.0f;
+            lanes.mul[v] = 1.0f;
+            lanes.add[v] = 0.0f;
+        }
+    }
+
+    for (int v = 0; v < maxVoices; ++v)
+    {
+        phase[v] = 0;
+        fixedIncrement[v] = 0.0f;
+        active[v] = false;
+        startOrder[v] = 0;
+    }
+
+    nextStartOrder = 0;
+    numActive = 0;
+    newest = -1;
+}
+
+void VoicePool::startVoice(float keepFactor, float newFixedIncrement) noexcept
+{
+    int voice = -1;
+    for (int v = 0; v < numVoices && voice < 0; ++v)
+        if (!active[v])
+            voice = v;
+
+    float keep = 0.0f;  // Free voices start from zero
+
+    if (voice < 0)
+    {
+        // Steal the oldest voice (wrap-safe age)
+        voice = 0;
+        for (int v = 1; v < numVoices; ++v)
+            if (nextStartOrder - startOrder[v] > nextStartOrder - startOrder[voice])
+                voice = v;
+
+        keep = keepFactor;
+    }
+
+    if (!active[voice])
+    {
+        active[voice] = true;
+        ++numActive;
+    }
+
+    startOrder[voice] = nextStartOrder++;
+    fixedIncrement[voice] = newFixedIncrement;
+    newest = voice;
+    startAttack(voice, keep);
+}
+
+void VoicePool::retriggerNewest(float keepFactor) noexcept
+{
+    if (newest >= 0 && active[newest])
+        startAttack(newest, keepFactor);
+    else
+        startVoice(keepFactor, 0.0f);
+}
+
+void VoicePool::startAttack(int voice, float keepFactor) noexcept
+{
+    for (int e = 0; e < numEnvelopes; ++e)
+    {
+        auto& lanes = env[e];
+        lanes.value[voice] *= keepFactor;
+        lanes.direction[voice] = 1.0f;
+        lanes.mul[voice] = attackSegment[e].mul;
+        lanes.add[voice] = attackSegment[e].add;
+    }
+
+    phase[voice] = WavetableBank::quarterCycle;  // Start a quarter cycle in (sine peak)
+}
+
+void VoicePool::handleBoundaries(int envelope) noexcept
+{
+    auto& lanes = env[envelope];
+
+    for (int v = 0; v < maxVoices; ++v)
+    {
+        if (lanes.direction[v] > 0.0f && lanes.value[v] >= 1.0f)
+        {
+            lanes.value[v] = 1.0f;
+            lanes.direction[v] = -1.0f;
+            lanes.mul[v] = decaySegment[envelope].mul;
+            lanes.add[v] = decaySegment[envelope].add;
+        }
+        else if (lanes.direction[v] < 0.0f && lanes.value[v] <= 0.0f)
+        {
+            lanes.value[v] = 0.0f;
+            lanes.direction[v] = 0.0f;
+            lanes.mul[v] = 1.0f;
+            lanes.add[v] = 0.0f;
+
+            if (envelope == ampEnv)
+                finishVoice(v);
+        }
+    }
+}
+
+void VoicePool::finishVoice(int voice) noexcept
+{
+    // The voice's other envelopes freeze where they are (as with the single-voice engine)
+    for (auto& lanes : env)
+    {
+        lanes.direction[voice] = 0.0f;
+        lanes.mul[voice] = 1.0f;
+        lanes.add[voice] = 0.0f;
+    }
+
+    active[voice] = false;
+    --numActive;
+}
+
+int VoicePool::render(const RenderSettings& settings, float* dest, float* colorDest, float* ampDest, int numSamples) noexcept
+{
+    const int oversampling = settings.colorOversampling;
+    jassert (juce::isPowerOfTwo(oversampling));
+
+    if (numActive == 0)
+    {
+        std::fill(dest, dest + numSamples, 0.0f);
+        std::fill(colorDest, colorDest + numSamples * oversampling, 0.0f);
+        std::fill(ampDest, ampDest + numSamples, 0.0f);
+        return 0;
+    }
+
+    jassert (settings.bank != nullptr);
+
+    if (oversampling > 1)
+        return renderVoices<true>(settings, dest, colorDest, ampDest, numSamples);
+
+    return renderVoices<false>(settings, dest, colorDest, ampDest, numSamples);
+}
+
+template <bool Oversampled>
+int VoicePool::renderVoices(const RenderSettings& settings, float* dest, float* colorDest, float* ampDest, int numSamples) noexcept
+{
+    const auto& bank = *settings.bank;
+    const int oversampling = Oversampled ? settings.colorOversampling : 1;
+
+    // Dirty oscillator (harmonic-rich layer) mixed in by the COLOR envelope
+    const float colorAmount = settings.colorAmount;
+    const float drive = 1.0f + 4.0f * colorAmount;  // Drive scales with COLOR amount
+    const float evenHarmonics = 0.15f * colorAmount;
+    const int oversamplingShift = juce::findHighestSetBit((juce::uint32) oversampling);
+
+    alignas(32) float increment[maxVoices];
+    alignas(32) float osc[maxVoices];
+    alignas(32) float colorWeight[maxVoices];
+    juce::uint32 previousPhase[maxVoices];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // 1. Envelopes: one recurrence step for every lane
+        for (auto& lanes : env)
+            for (int v = 0; v < maxVoices; ++v)
+                lanes.value[v] = lanes.value[v] * lanes.mul[v] + lanes.add[v];
+
+        // Boundary test: d * (y - 0.5) - 0.5 >= 0 exactly when a lane reached its end point
+        // (attack: y >= 1, decay: y <= 0, done: never). Amp last so finishing freezes the rest.
+        for (int e : { (int) pitchEnv, (int) colorEnv, (int) ampEnv })
+        {
+            const auto& lanes = env[e];
+            float crossing = -1.0f;
+            for (int v = 0; v < maxVoices; ++v)
+                crossing = juce::jmax(crossing, lanes.direction[v] * (lanes.value[v] - 0.5f) - 0.5f);
+
+            if (crossing >= 0.0f)
+                handleBoundaries(e);
+        }
+
+        // 2. Phase increments: pitch envelope sweep, or a fixed MIDI pitch
+        const auto& pitch = env[pitchEnv].value;
+        for (int v = 0; v < maxVoices; ++v)
+        {
+            const float sweep = settings.startIncrement + pitch[v] * settings.rangeIncrement;
+            increment[v] = fixedIncrement[v] > 0.0f ? fixedIncrement[v] : sweep;
+        }
+
+        for (int v = 0; v < maxVoices; ++v)
+        {
+            previousPhase[v] = phase[v];
+            phase[v] += (juce::uint32) increment[v];
+        }
+
+        // 3. Band-limited table read (the table is picked per voice so pitch sweeps never alias)
+        for (int v = 0; v < maxVoices; ++v)
+            osc[v] = active[v] ? WavetableBank::read(bank.getTable(settings.shape, (juce::uint32) increment[v]), phase[v]) : 0.0f;
+
+        // 4. Clean layer + amplitude envelope, summed over voices (branch-free)
+        const auto& amp = env[ampEnv].value;
+        const auto& color = env[colorEnv].value;
+        float sum = 0.0f, ampSum = 0.0f;
+        for (int v = 0; v < maxVoices; ++v)
+        {
+            const float colorMix = colorAmount * color[v];  // Dynamic modulation
+            colorWeight[v] = colorMix * amp[v];
+            sum += osc[v] * (amp[v] - colorWeight[v]);
+            ampSum += amp[v];
+        }
+
+        dest[i] = sum;
+        ampDest[i] = ampSum;
+
+        // 5. COLOR layer: shaped at the base rate, or re-read from the tables at the
+        //    oversampled rate (sub-sample phases) so the shaper's harmonics stay above
+        //    the decimator's passband instead of folding back
+        auto* colorOut = colorDest + (i << oversamplingShift);
+        if constexpr (! Oversampled)
+        {
+            float colorSum = 0.0f;
+            for (int v = 0; v < maxVoices; ++v)
+                colorSum += shapeColor(osc[v], drive, evenHarmonics) * colorWeight[v];
+
+            colorOut[0] = colorSum;
+        }
+        else
+        {
+            std::fill(colorOut, colorOut + oversampling, 0.0f);
+
+            for (int v = 0; v < maxVoices; ++v)
+            {
+                if (!active[v] || colorWeight[v] == 0.0f)
+                    continue;
+
+                const auto subIncrement = (juce::uint32) increment[v] >> oversamplingShift;
+                const float* table = bank.getTable(settings.shape, subIncrement);
+                juce::uint32 subPhase = previousPhase[v];
+
+                for (int j = 0; j < oversampling; ++j)
+                {
+                    subPhase += subIncrement;
+                    colorOut[j] += shapeColor(WavetableBank::read(table, subPhase), drive, evenHarmonics) * colorWeight[v];
+                }
+            }
+        }
+
+        if (numActive == 0)
+        {
+            std::fill(dest + i + 1, dest + numSamples, 0.0f);
+            std::fill(colorDest + ((i + 1) << oversamplingShift), colorDest + (numSamples << oversamplingShift), 0.0f);
+            std::fill(ampDest + i + 1, ampDest + numSamples, 0.0f);
+            return i + 1;
+        }
+    }
+
+    return numSamples;
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+    VoicePool.h (SPLENTA V19.6 - 20261016.01)
+    Preallocated Sub Voices in Structure-of-Arrays Layout
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SegmentEnvelope.h"
+#include "WavetableBank.h"
+
+// Fixed pool of sub voices (phase + pitch/amp/COLOR envelopes each). Every field
+// is an array indexed by voice, so one sample of all voices is a set of
+// independent lane operations: the envelope recurrences, phase increments and
+// waveshaper compile to vector instructions and overlapping hits ring out for
+// roughly the cost of one voice. A new hit takes a free voice or steals the
+// oldest one; only the stolen voice is retriggered (soft/hard keep factor).
+class VoicePool
+{
+public:
+    static constexpr int maxVoices = 8;
+
+    // Per-block oscillator settings (phase increments in fixed-point units, 2^32 = one cycle)
+    struct RenderSettings
+    {
+        const WavetableBank* bank = nullptr;
+        int shape = 0;
+        float startIncrement = 0.0f;   // START_FREQ
+        float rangeIncrement = 0.0f;   // PEAK_FREQ - START_FREQ, scaled by the pitch envelope
+        float colorAmount = 0.0f;      // 0.0 - 1.0
+        int colorOversampling = 1;     // COLOR layer rate (1, 2, 4 or 8 x)
+    };
+
+    VoicePool() { reset(); }
+
+    // Segment lengths in samples; curve shapes the decay segments (0 = linear)
+    void setEnvelopeSegments(float pitchAtt, float pitchDec, float ampAtt, float ampDec,
+                             float colorAtt, float colorDec, float curve) noexcept;
+
+    // Voices that may be allocated (voices above the limit still ring out)
+    void setNumVoices(int newNumVoices) noexcept { numVoices = juce::jlimit(1, maxVoices, newNumVoices); }
+
+    void reset() noexcept;
+
+    // New hit: starts a free voice or steals the oldest one (stolen voices keep keepFactor of
+    // their envelope values). fixedIncrement > 0 pins the pitch (MIDI pitch mode).
+    void startVoice(float keepFactor, float fixedIncrement) noexcept;
+
+    // Restarts the most recent voice's attack (trigger held above threshold)
+    void retriggerNewest(float keepFactor) noexcept;
+
+    bool isActive() const noexcept { return numActive > 0; }
+
+    // Pitch envelope of the most recent voice (UI frequency display)
+    float getNewestPitch() const noexcept { return newest >= 0 ? env[pitchEnv].value[newest] : 0.0f; }
+
+    // Renders the clean layer of all voices into dest, the shaped COLOR layer into colorDest
+    // (numSamples * colorOversampling samples) and the summed amplitude envelopes into ampDest.
+    // If the last voice finishes inside this call, returns the number of samples up to and
+    // including the finishing one (the rest are 0); otherwise numSamples (0 when nothing played).
+    int render(const RenderSettings& settings, float* dest, float* colorDest, float* ampDest, int numSamples) noexcept;
+
+private:
+    enum EnvelopeIndex { pitchEnv = 0, ampEnv, colorEnv, numEnvelopes };
+
+    // Stage per lane as a direction: +1 attack, -1 decay, 0 done (lets the boundary test stay branch-free)
+    struct EnvelopeLanes
+    {
+        alignas(32) float value[maxVoices];
+        alignas(32) float direction[maxVoices];
+        alignas(32) float mul[maxVoices];
+        alignas(32) float add[maxVoices];
+    };
+
+    // Per-sample loop specialised on whether the COLOR layer is oversampled
+    template <bool Oversampled>
+    int renderVoices(const RenderSettings& settings, float* dest, float* colorDest, float* ampDest, int numSamples) noexcept;
+
+    void startAttack(int voice, float keepFactor) noexcept;
+    void handleBoundaries(int envelope) noexcept;
+    void finishVoice(int voice) noexcept;
+
+    EnvelopeLanes env[numEnvelopes];
+    SegmentEnvelope::Segment attackSegment[numEnvelopes], decaySegment[numEnvelopes];
+
+    alignas(32) juce::uint32 phase[maxVoices];
+    alignas(32) float fixedIncrement[maxVoices];
+    bool active[maxVoices];
+    juce::uint32 startOrder[maxVoices];
+
+    juce::uint32 nextStartOrder = 0;
+    int numVoices = maxVoices;
+    int numActive = 0;
+    int newest = -1;
+};
@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+    WavetableBank.cpp (SPLENTA V19.6 - 20261016.01)
+    Shared Band-Limited Wavetables for the SHAPE Oscillator
+  ==============================================================================
+*/
+
+#include "WavetableBank.h"
+
+WavetableBank::WavetableBank()
+{
+    tables.resize((size_t) (numShapes * numOctaves * (tableSize + 1)), 0.0f);
+
+    // One cycle of sine; sin(n * theta) is then an exact lookup at (n * j) mod N
+    std::vector<double> sineCycle((size_t) tableSize);
+    for (int j = 0; j < tableSize; ++j)
+        sineCycle[(size_t) j] = std::sin(juce::MathConstants<double>::twoPi * j / tableSize);
+
+    std::vector<double> accumulator((size_t) tableSize);
+    constexpr int cosineOffset = tableSize / 4;
+    constexpr double pi = juce::MathConstants<double>::pi;
+
+    for (int shape = 0; shape < numShapes; ++shape)
+    {
+        for (int octave = 0; octave < numOctaves; ++octave)
+        {
+            const int maxHarmonic = (tableSize / 2) >> octave;
+            std::fill(accumulator.begin(), accumulator.end(), 0.0);
+
+            // Fourier series of the former naive shapes, truncated to maxHarmonic:
+            //   sine     = sin(theta)
+            //   triangle = 1 - 2|theta/pi - 1| = -(8/pi^2) * sum_odd cos(n theta) / n^2
+            //   square   = theta < pi ? 1 : -1  =  (4/pi)   * sum_odd sin(n theta) / n
+            for (int n = 1; n <= maxHarmonic; ++n)
+            {
+                double amplitude = 0.0;
+                int offset = 0;
+
+                if (shape == sine)
+                {
+                    if (n > 1) break;
+                    amplitude = 1.0;
+                }
+                else if ((n & 1) == 0)
+                {
+                    continue;
+                }
+                else if (shape == triangle)
+                {
+                    amplitude = -8.0 / (pi * pi * n * n);
+                    offset = cosineOffset;
+                }
+                else
+                {
+                    amplitude = 4.0 / (pi * n);
+                }
+
+                for (int j = 0; j < tableSize; ++j)
+                    accumulator[(size_t) j] += amplitude * sineCycle[(size_t) ((n * j + offset) & (tableSize - 1))];
+            }
+
+            auto* table = tables.data() + (size_t) (shape * numOctaves + octave) * (size_t) (tableSize + 1);
+            for (int j = 0; j < tableSize; ++j)
+                table[j] = (float) accumulator[(size_t) j];
+
+            table[tableSize] = table[0];  // Guard point for interpolation
+        }
+    }
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+    WavetableBank.h (SPLENTA V19.6 - 20261016.01)
+    Shared Band-Limited Wavetables for the SHAPE Oscillator
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Precomputed band-limited tables, one per octave for each SHAPE choice.
+// Built once and shared by every plugin instance (juce::SharedResourcePointer).
+// Phase is a 32-bit fixed-point accumulator: 2^32 = one cycle.
+class WavetableBank
+{
+public:
+    enum Shape { sine = 0, triangle, square, numShapes };  // Matches the SHAPE parameter
+
+    static constexpr int tableBits = 11;
+    static constexpr int tableSize = 1 << tableBits;   // 2048 samples per cycle
+    static constexpr int numOctaves = 11;              // Table 0 = 1024 harmonics, table 10 = 1
+    static constexpr juce::uint32 quarterCycle = 0x40000000u;
+
+    WavetableBank();
+
+    // Table (tableSize + 1 samples, last = wrap guard) that is alias-free at this increment
+    const float* getTable(int shape, juce::uint32 phaseIncrement) const noexcept
+    {
+        // Table k holds (1024 >> k) harmonics, valid for increments below 2^(21 + k)
+        const int octave = (shape == sine) ? 0
+                         : juce::jlimit(0, numOctaves - 1, juce::findHighestSetBit(phaseIncrement) - 20);
+        return tables.data() + (size_t) (shape * numOctaves + octave) * (size_t) (tableSize + 1);
+    }
+
+    // Linear interpolation between adjacent table points
+    static float read(const float* table, juce::uint32 phase) noexcept
+    {
+        constexpr int fractionBits = 32 - tableBits;
+        constexpr float fractionScale = 1.0f / (float) (1u << fractionBits);
+
+        const auto index = (int) (phase >> fractionBits);
+        const float fraction = (float) (phase & ((1u << fractionBits) - 1u)) * fractionScale;
+        return table[index] + fraction * (table[index + 1] - table[index]);
+    }
+
+private:
+    std::vector<float> tables;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WavetableBank)
+};